@@ -99,6 +99,8 @@ C64::C64()
         { &durationOfOneCycle, sizeof(durationOfOneCycle), KEEP_ON_RESET  },
         { &warp,               sizeof(warp),               CLEAR_ON_RESET },
         { &ultimax,            sizeof(ultimax),            CLEAR_ON_RESET },
+        { trigger,             sizeof(trigger),            CLEAR_ON_RESET },
+        { &nextTrigger,        sizeof(nextTrigger),        CLEAR_ON_RESET },
         
         { NULL,             0,                       0 }};
     
@@ -109,9 +111,6 @@ C64::C64()
     drive1.powerOn();
     drive2.powerOff();
     
-    // Initialize mach timer info
-    mach_timebase_info(&timebase);
-
     reset();
 }
 
@@ -120,6 +119,7 @@ C64::~C64()
     debug(RUN_DEBUG, "Destroying virtual C64[%p]\n", this);
     
     halt();
+    delete scratchSnapshot;
 }
 
 void
@@ -251,100 +251,27 @@ C64::setModel(C64Model m)
 void
 C64::updateVicFunctionTable()
 {
-    // Assign model independent execution functions
-    vicfunc[0] = NULL;
-    vicfunc[12] = &VIC::cycle12;
-    vicfunc[13] = &VIC::cycle13;
-    vicfunc[14] = &VIC::cycle14;
-    vicfunc[15] = &VIC::cycle15;
-    vicfunc[16] = &VIC::cycle16;
-    vicfunc[17] = &VIC::cycle17;
-    vicfunc[18] = &VIC::cycle18;
-    
-    for (unsigned cycle = 19; cycle <= 54; cycle++)
-        vicfunc[cycle] = &VIC::cycle19to54;
-
-    vicfunc[56] = &VIC::cycle56;
-    
-    // Assign model specific execution functions
     switch (vic.getModel()) {
             
         case PAL_6569_R1:
         case PAL_6569_R3:
-        case PAL_8565:
+            assignVicFunctions<PAL_6569_R3>();
+            break;
             
-            vicfunc[1] = &VIC::cycle1pal;
-            vicfunc[2] = &VIC::cycle2pal;
-            vicfunc[3] = &VIC::cycle3pal;
-            vicfunc[4] = &VIC::cycle4pal;
-            vicfunc[5] = &VIC::cycle5pal;
-            vicfunc[6] = &VIC::cycle6pal;
-            vicfunc[7] = &VIC::cycle7pal;
-            vicfunc[8] = &VIC::cycle8pal;
-            vicfunc[9] = &VIC::cycle9pal;
-            vicfunc[10] = &VIC::cycle10pal;
-            vicfunc[11] = &VIC::cycle11pal;
-            vicfunc[55] = &VIC::cycle55pal;
-            vicfunc[57] = &VIC::cycle57pal;
-            vicfunc[58] = &VIC::cycle58pal;
-            vicfunc[59] = &VIC::cycle59pal;
-            vicfunc[60] = &VIC::cycle60pal;
-            vicfunc[61] = &VIC::cycle61pal;
-            vicfunc[62] = &VIC::cycle62pal;
-            vicfunc[63] = &VIC::cycle63pal;
-            vicfunc[64] = NULL;
-            vicfunc[65] = NULL;
+        case PAL_8565:
+            assignVicFunctions<PAL_8565>();
             break;
             
         case NTSC_6567_R56A:
-            
-            vicfunc[1] = &VIC::cycle1pal;
-            vicfunc[2] = &VIC::cycle2pal;
-            vicfunc[3] = &VIC::cycle3pal;
-            vicfunc[4] = &VIC::cycle4pal;
-            vicfunc[5] = &VIC::cycle5pal;
-            vicfunc[6] = &VIC::cycle6pal;
-            vicfunc[7] = &VIC::cycle7pal;
-            vicfunc[8] = &VIC::cycle8pal;
-            vicfunc[9] = &VIC::cycle9pal;
-            vicfunc[10] = &VIC::cycle10pal;
-            vicfunc[11] = &VIC::cycle11pal;
-            vicfunc[55] = &VIC::cycle55ntsc;
-            vicfunc[57] = &VIC::cycle57ntsc;
-            vicfunc[58] = &VIC::cycle58ntsc;
-            vicfunc[59] = &VIC::cycle59ntsc;
-            vicfunc[60] = &VIC::cycle60ntsc;
-            vicfunc[61] = &VIC::cycle61ntsc;
-            vicfunc[62] = &VIC::cycle62ntsc;
-            vicfunc[63] = &VIC::cycle63ntsc;
-            vicfunc[64] = &VIC::cycle64ntsc;
-            vicfunc[65] = NULL;
+            assignVicFunctions<NTSC_6567_R56A>();
             break;
             
         case NTSC_6567:
-        case NTSC_8562:
+            assignVicFunctions<NTSC_6567>();
+            break;
             
-            vicfunc[1] = &VIC::cycle1ntsc;
-            vicfunc[2] = &VIC::cycle2ntsc;
-            vicfunc[3] = &VIC::cycle3ntsc;
-            vicfunc[4] = &VIC::cycle4ntsc;
-            vicfunc[5] = &VIC::cycle5ntsc;
-            vicfunc[6] = &VIC::cycle6ntsc;
-            vicfunc[7] = &VIC::cycle7ntsc;
-            vicfunc[8] = &VIC::cycle8ntsc;
-            vicfunc[9] = &VIC::cycle9ntsc;
-            vicfunc[10] = &VIC::cycle10ntsc;
-            vicfunc[11] = &VIC::cycle11ntsc;
-            vicfunc[55] = &VIC::cycle55ntsc;
-            vicfunc[57] = &VIC::cycle57ntsc;
-            vicfunc[58] = &VIC::cycle58ntsc;
-            vicfunc[59] = &VIC::cycle59ntsc;
-            vicfunc[60] = &VIC::cycle60ntsc;
-            vicfunc[61] = &VIC::cycle61ntsc;
-            vicfunc[62] = &VIC::cycle62ntsc;
-            vicfunc[63] = &VIC::cycle63ntsc;
-            vicfunc[64] = &VIC::cycle64ntsc;
-            vicfunc[65] = &VIC::cycle65ntsc;
+        case NTSC_8562:
+            assignVicFunctions<NTSC_8562>();
             break;
             
         default:
@@ -439,6 +366,7 @@ C64::isHalted()
 void
 C64::step()
 {
+    cpu.leaveIdleLoop();
     cpu.clearErrorState();
     drive1.cpu.clearErrorState();
     drive2.cpu.clearErrorState();
@@ -475,10 +403,23 @@ C64::stepOver()
 bool
 C64::executeOneLine()
 {
-    if (rasterCycle == 1)
-    beginRasterLine();
-    
     int lastCycle = vic.getCyclesPerRasterline();
+    
+    // Take the fast path if the complete rasterline needs to be processed
+    if (rasterCycle == 1) {
+        
+        beginRasterLine();
+        
+        unsigned drives = drive1.isPoweredOn() | (drive2.isPoweredOn() << 1);
+        if (!(this->*linefunc[drives])()) {
+            if (rasterCycle > lastCycle)
+            endRasterLine();
+            return false;
+        }
+        endRasterLine();
+        return true;
+    }
+    
     for (unsigned i = rasterCycle; i <= lastCycle; i++) {
         if (!_executeOneCycle()) {
             if (i == lastCycle)
@@ -500,6 +441,22 @@ C64::executeOneFrame()
     return true;
 }
 
+bool
+C64::executeUntil(u64 targetCycle)
+{
+    while (cpu.cycle < targetCycle) {
+        
+        unsigned remaining = vic.getCyclesPerRasterline() - rasterCycle + 1;
+        
+        if (rasterCycle == 1 && targetCycle - cpu.cycle >= remaining) {
+            if (!executeOneLine()) return false;
+        } else {
+            if (!executeOneCycle()) return false;
+        }
+    }
+    return true;
+}
+
 bool
 C64::executeOneCycle()
 {
@@ -513,6 +470,19 @@ C64::executeOneCycle()
     return result;
 }
 
+inline void
+C64::serviceEvents(u64 cycle)
+{
+    if (cycle >= trigger[EVENT_CIA1]) cia1.executeOneCycle();
+    if (cycle >= trigger[EVENT_CIA2]) cia2.executeOneCycle();
+    if (cycle >= trigger[EVENT_IEC]) {
+        trigger[EVENT_IEC] = NEVER;
+        iec.updateIecLinesC64Side();
+    }
+    
+    nextTrigger = MIN(trigger[EVENT_CIA1], MIN(trigger[EVENT_CIA2], trigger[EVENT_IEC]));
+}
+
 bool
 C64::_executeOneCycle()
 {
@@ -539,21 +509,200 @@ C64::_executeOneCycle()
     
     // First clock phase (o2 low)
     (vic.*vicfunc[rasterCycle])();
-    if (cycle >= cia1.wakeUpCycle) cia1.executeOneCycle(); else cia1.idleCounter++;
-    if (cycle >= cia2.wakeUpCycle) cia2.executeOneCycle(); else cia2.idleCounter++;
-    if (iec.isDirtyC64Side) iec.updateIecLinesC64Side();
+    if (cycle >= nextTrigger) serviceEvents(cycle);
     
     // Second clock phase (o2 high)
-    result &= cpu.executeOneCycle();
+    result &= cpu.executeC64Cycle();
     if (drive1.isPoweredOn()) result &= drive1.execute(durationOfOneCycle);
     if (drive2.isPoweredOn()) result &= drive2.execute(durationOfOneCycle);
     // if (iec.isDirtyDriveSide) iec.updateIecLinesDriveSide();
-    datasette.execute();
+    if (cycle >= trigger[EVENT_TAPE]) datasette.execute();
+    
+    rasterCycle++;
+    return result;
+}
+
+template <void (VIC::*vicCycle)(), bool drive1On, bool drive2On> bool
+C64::executeCycle()
+{
+    u8 result = true;
+    u64 cycle = ++cpu.cycle;
+    
+    // First clock phase (o2 low)
+    (vic.*vicCycle)();
+    if (cycle >= nextTrigger) serviceEvents(cycle);
+    
+    // Second clock phase (o2 high)
+    result &= cpu.executeC64Cycle();
+    if (drive1On) result &= drive1.execute(durationOfOneCycle);
+    if (drive2On) result &= drive2.execute(durationOfOneCycle);
+    if (cycle >= trigger[EVENT_TAPE]) datasette.execute();
     
     rasterCycle++;
     return result;
 }
 
+#define EXECUTE_CYCLE(func) \
+if (unlikely(!(executeCycle<&VIC::func<model>, drive1On, drive2On>()))) return false;
+
+template <VICModel model, bool drive1On, bool drive2On> bool
+C64::executeLine()
+{
+    assert(rasterCycle == 1);
+    
+    const bool pal = VIC::isPAL(model);
+    const bool ntsc65 = !pal && model != NTSC_6567_R56A;
+    
+    // Cycles 1 to 11
+    if (ntsc65) {
+        EXECUTE_CYCLE(cycle1ntsc);
+        EXECUTE_CYCLE(cycle2ntsc);
+        EXECUTE_CYCLE(cycle3ntsc);
+        EXECUTE_CYCLE(cycle4ntsc);
+        EXECUTE_CYCLE(cycle5ntsc);
+        EXECUTE_CYCLE(cycle6ntsc);
+        EXECUTE_CYCLE(cycle7ntsc);
+        EXECUTE_CYCLE(cycle8ntsc);
+        EXECUTE_CYCLE(cycle9ntsc);
+        EXECUTE_CYCLE(cycle10ntsc);
+        EXECUTE_CYCLE(cycle11ntsc);
+    } else {
+        EXECUTE_CYCLE(cycle1pal);
+        EXECUTE_CYCLE(cycle2pal);
+        EXECUTE_CYCLE(cycle3pal);
+        EXECUTE_CYCLE(cycle4pal);
+        EXECUTE_CYCLE(cycle5pal);
+        EXECUTE_CYCLE(cycle6pal);
+        EXECUTE_CYCLE(cycle7pal);
+        EXECUTE_CYCLE(cycle8pal);
+        EXECUTE_CYCLE(cycle9pal);
+        EXECUTE_CYCLE(cycle10pal);
+        EXECUTE_CYCLE(cycle11pal);
+    }
+    
+    // Cycles 12 to 54 (model independent)
+    EXECUTE_CYCLE(cycle12);
+    EXECUTE_CYCLE(cycle13);
+    EXECUTE_CYCLE(cycle14);
+    EXECUTE_CYCLE(cycle15);
+    EXECUTE_CYCLE(cycle16);
+    EXECUTE_CYCLE(cycle17);
+    EXECUTE_CYCLE(cycle18);
+    for (unsigned i = 19; i <= 54; i++) {
+        EXECUTE_CYCLE(cycle19to54);
+    }
+    
+    // Cycles 55 to 65
+    if (pal) {
+        EXECUTE_CYCLE(cycle55pal);
+        EXECUTE_CYCLE(cycle56);
+        EXECUTE_CYCLE(cycle57pal);
+        EXECUTE_CYCLE(cycle58pal);
+        EXECUTE_CYCLE(cycle59pal);
+        EXECUTE_CYCLE(cycle60pal);
+        EXECUTE_CYCLE(cycle61pal);
+        EXECUTE_CYCLE(cycle62pal);
+        EXECUTE_CYCLE(cycle63pal);
+    } else {
+        EXECUTE_CYCLE(cycle55ntsc);
+        EXECUTE_CYCLE(cycle56);
+        EXECUTE_CYCLE(cycle57ntsc);
+        EXECUTE_CYCLE(cycle58ntsc);
+        EXECUTE_CYCLE(cycle59ntsc);
+        EXECUTE_CYCLE(cycle60ntsc);
+        EXECUTE_CYCLE(cycle61ntsc);
+        EXECUTE_CYCLE(cycle62ntsc);
+        EXECUTE_CYCLE(cycle63ntsc);
+        EXECUTE_CYCLE(cycle64ntsc);
+        if (ntsc65) {
+            EXECUTE_CYCLE(cycle65ntsc);
+        }
+    }
+    
+    return true;
+}
+
+#undef EXECUTE_CYCLE
+
+template <VICModel model> void
+C64::assignVicFunctions()
+{
+    const bool pal = VIC::isPAL(model);
+    const bool ntsc65 = !pal && model != NTSC_6567_R56A;
+    
+    vicfunc[0] = NULL;
+    
+    // Cycles 1 to 11
+    if (ntsc65) {
+        vicfunc[1] = &VIC::cycle1ntsc<model>;
+        vicfunc[2] = &VIC::cycle2ntsc<model>;
+        vicfunc[3] = &VIC::cycle3ntsc<model>;
+        vicfunc[4] = &VIC::cycle4ntsc<model>;
+        vicfunc[5] = &VIC::cycle5ntsc<model>;
+        vicfunc[6] = &VIC::cycle6ntsc<model>;
+        vicfunc[7] = &VIC::cycle7ntsc<model>;
+        vicfunc[8] = &VIC::cycle8ntsc<model>;
+        vicfunc[9] = &VIC::cycle9ntsc<model>;
+        vicfunc[10] = &VIC::cycle10ntsc<model>;
+        vicfunc[11] = &VIC::cycle11ntsc<model>;
+    } else {
+        vicfunc[1] = &VIC::cycle1pal<model>;
+        vicfunc[2] = &VIC::cycle2pal<model>;
+        vicfunc[3] = &VIC::cycle3pal<model>;
+        vicfunc[4] = &VIC::cycle4pal<model>;
+        vicfunc[5] = &VIC::cycle5pal<model>;
+        vicfunc[6] = &VIC::cycle6pal<model>;
+        vicfunc[7] = &VIC::cycle7pal<model>;
+        vicfunc[8] = &VIC::cycle8pal<model>;
+        vicfunc[9] = &VIC::cycle9pal<model>;
+        vicfunc[10] = &VIC::cycle10pal<model>;
+        vicfunc[11] = &VIC::cycle11pal<model>;
+    }
+    
+    // Cycles 12 to 54 (model independent layout)
+    vicfunc[12] = &VIC::cycle12<model>;
+    vicfunc[13] = &VIC::cycle13<model>;
+    vicfunc[14] = &VIC::cycle14<model>;
+    vicfunc[15] = &VIC::cycle15<model>;
+    vicfunc[16] = &VIC::cycle16<model>;
+    vicfunc[17] = &VIC::cycle17<model>;
+    vicfunc[18] = &VIC::cycle18<model>;
+    for (unsigned cycle = 19; cycle <= 54; cycle++)
+        vicfunc[cycle] = &VIC::cycle19to54<model>;
+    
+    // Cycles 55 to 65
+    vicfunc[56] = &VIC::cycle56<model>;
+    if (pal) {
+        vicfunc[55] = &VIC::cycle55pal<model>;
+        vicfunc[57] = &VIC::cycle57pal<model>;
+        vicfunc[58] = &VIC::cycle58pal<model>;
+        vicfunc[59] = &VIC::cycle59pal<model>;
+        vicfunc[60] = &VIC::cycle60pal<model>;
+        vicfunc[61] = &VIC::cycle61pal<model>;
+        vicfunc[62] = &VIC::cycle62pal<model>;
+        vicfunc[63] = &VIC::cycle63pal<model>;
+        vicfunc[64] = NULL;
+        vicfunc[65] = NULL;
+    } else {
+        vicfunc[55] = &VIC::cycle55ntsc<model>;
+        vicfunc[57] = &VIC::cycle57ntsc<model>;
+        vicfunc[58] = &VIC::cycle58ntsc<model>;
+        vicfunc[59] = &VIC::cycle59ntsc<model>;
+        vicfunc[60] = &VIC::cycle60ntsc<model>;
+        vicfunc[61] = &VIC::cycle61ntsc<model>;
+        vicfunc[62] = &VIC::cycle62ntsc<model>;
+        vicfunc[63] = &VIC::cycle63ntsc<model>;
+        vicfunc[64] = &VIC::cycle64ntsc<model>;
+        vicfunc[65] = ntsc65 ? &VIC::cycle65ntsc<model> : NULL;
+    }
+    
+    // Complete rasterlines
+    linefunc[0] = &C64::executeLine<model, false, false>;
+    linefunc[1] = &C64::executeLine<model, true, false>;
+    linefunc[2] = &C64::executeLine<model, false, true>;
+    linefunc[3] = &C64::executeLine<model, true, true>;
+}
+
 void
 C64::beginRasterLine()
 {
@@ -600,7 +749,7 @@ C64::endFrame()
     mouse.execute();
     
     // Take a snapshot once in a while
-    if (takeAutoSnapshots && autoSnapshotInterval > 0) {
+    if (takeAutoSnapshots && autoSnapshotInterval > 0 && !seeking) {
         unsigned fps = (unsigned)vic.getFramesPerSecond();
         if (frame % (fps * autoSnapshotInterval) == 0) {
             takeAutoSnapshot();
@@ -608,7 +757,7 @@ C64::endFrame()
     }
     
     // Count some sheep (zzzzzz) ...
-    if (!getWarp()) {
+    if (!getWarp() && !seeking) {
             synchronizeTiming();
     }
 }
@@ -662,10 +811,7 @@ C64::setWarpLoad(bool b)
 void
 C64::restartTimer()
 {
-    u64 kernelNow = mach_absolute_time();
-    u64 nanoNow = abs_to_nanos(kernelNow);
-    
-    nanoTargetTime = nanoNow + vic.getFrameDelay();
+    nanoTargetTime = monotonicNanos() + vic.getFrameDelay();
 }
 
 void
@@ -674,7 +820,7 @@ C64::synchronizeTiming()
     const u64 earlyWakeup = 1500000; /* 1.5 milliseconds */
     
     // Get current time in nano seconds
-    u64 nanoAbsTime = abs_to_nanos(mach_absolute_time());
+    u64 nanoAbsTime = monotonicNanos();
     
     // Check how long we're supposed to sleep
     i64 timediff = (i64)nanoTargetTime - (i64)nanoAbsTime;
@@ -687,11 +833,8 @@ C64::synchronizeTiming()
         restartTimer();
     }
     
-    // Convert nanoTargetTime into kernel unit
-    i64 kernelTargetTime = nanos_to_abs(nanoTargetTime);
-    
     // Sleep and update target timer
-    i64 jitter = sleepUntil(kernelTargetTime, earlyWakeup);
+    i64 jitter = sleepUntil(nanoTargetTime, earlyWakeup);
     nanoTargetTime += vic.getFrameDelay();
     
     if (jitter > 1000000000 /* 1 sec */) {
@@ -704,40 +847,86 @@ C64::synchronizeTiming()
     }
 }
 
-void C64::loadFromSnapshotUnsafe(Snapshot *snapshot)
+bool
+C64::loadFromSnapshotUnsafe(Snapshot *snapshot)
 {    
     u8 *ptr;
     
-    if (snapshot && (ptr = snapshot->getData())) {
+    if (!snapshot) return false;
+    
+    // The blobs are owned by the original snapshot, even if it is a delta
+    const BlobList *blobs = &snapshot->getBlobs();
+    
+    // Reconstruct delta snapshots in the scratch buffer
+    if (snapshot->isDelta()) {
+        
+        size_t size = snapshot->fullSize();
+        if (!scratchSnapshot || scratchSnapshot->getSize() != size) {
+            delete scratchSnapshot;
+            scratchSnapshot = new Snapshot(size - sizeof(SnapshotHeader));
+        }
+        snapshot->restore((u8 *)scratchSnapshot->getHeader());
+        snapshot = scratchSnapshot;
+    }
+    
+    if (!(ptr = snapshot->getData())) return false;
+    
+    // Keep the current state in case a referenced blob is missing
+    Snapshot *backup = Snapshot::makeWithC64(this);
+    
+    // Start the next delta snapshot with a new keyframe
+    keyframe.reset();
+    
+    loadingBlobs = blobs;
+    missingBlob = false;
+    loadFromBuffer(&ptr);
+    
+    bool result = !missingBlob;
+    if (!result) {
+        
+        warn("Snapshot is incomplete. Restoring the previous state.\n");
+        ptr = backup->getData();
+        loadingBlobs = &backup->getBlobs();
         loadFromBuffer(&ptr);
-        keyboard.releaseAll(); // Avoid constantly pressed keys
-        ping();
+        assert(!missingBlob);
     }
+    loadingBlobs = NULL;
+    delete backup;
+    
+    keyboard.releaseAll(); // Avoid constantly pressed keys
+    ping();
+    return result;
 }
 
-void
+bool
 C64::loadFromSnapshotSafe(Snapshot *snapshot)
 {
     debug(SNP_DEBUG, "C64::loadFromSnapshotSafe\n");
 
     suspend();
-    loadFromSnapshotUnsafe(snapshot);
+    bool result = loadFromSnapshotUnsafe(snapshot);
     resume();
+    
+    return result;
 }
 
 bool
-C64::restoreSnapshot(vector<Snapshot *> &storage, unsigned nr)
+C64::restoreBlob(u64 fingerprint, BlobRef &ref, u8 *data, size_t size)
 {
-    Snapshot *snapshot = getSnapshot(storage, nr);
-    
-    if (snapshot) {
-        loadFromSnapshotSafe(snapshot);
+    if (BlobStore::restore(fingerprint, loadingBlobs, ref, data, size))
         return true;
-    }
     
+    warn("Blob %llx is not available.\n", fingerprint);
+    missingBlob = true;
     return false;
 }
 
+bool
+C64::restoreSnapshot(Snapshot *snapshot)
+{
+    return loadFromSnapshotSafe(snapshot);
+}
+
 size_t
 C64::numSnapshots(vector<Snapshot *> &storage)
 {
@@ -751,6 +940,43 @@ C64::getSnapshot(vector<Snapshot *> &storage, unsigned nr)
     
 }
 
+Snapshot *
+C64::makeDeltaSnapshot()
+{
+    size_t size = sizeof(SnapshotHeader) + stateSize();
+    size_t numPages = (size + Snapshot::PAGE_SIZE - 1) / Snapshot::PAGE_SIZE;
+    
+    if (!scratchSnapshot || scratchSnapshot->getSize() != size) {
+        delete scratchSnapshot;
+        scratchSnapshot = new Snapshot(stateSize());
+        keyframe.reset();
+    }
+    
+    // Record the current state in the scratch buffer
+    if (keyframe) {
+        
+        scratchSnapshot->updateState(this, dirtyPages);
+        
+        // Encode the state as a delta
+        Snapshot *delta = Snapshot::makeWithDelta(scratchSnapshot, keyframe, &dirtyPages);
+        if (delta->footprint() <= size / 4) return delta;
+        delete delta;
+        
+    } else {
+        
+        // Write everything and let all components forget their changes
+        dirtyPages.assign(numPages, false);
+        scratchSnapshot->takeState(this);
+        scratchSnapshot->updateState(this, dirtyPages);
+    }
+    
+    // Start over with a new keyframe
+    debug(SNP_DEBUG, "Recording new keyframe\n");
+    keyframe = std::shared_ptr<Snapshot>(Snapshot::makeWithBuffer((u8 *)scratchSnapshot->getHeader(), size));
+    dirtyPages.assign(numPages, false);
+    return Snapshot::makeWithDelta(scratchSnapshot, keyframe, &dirtyPages);
+}
+
 void
 C64::takeSnapshot(vector<Snapshot *> &storage)
 {
@@ -764,6 +990,47 @@ C64::takeSnapshot(vector<Snapshot *> &storage)
     putMessage(MSG_SNAPSHOT_TAKEN);
 }
 
+void
+C64::takeAutoSnapshot()
+{
+    autoSnapshots.record(frame, makeDeltaSnapshot());
+    putMessage(MSG_SNAPSHOT_TAKEN);
+}
+
+bool
+C64::seekToFrame(u64 target)
+{
+    u64 start;
+    Snapshot *snapshot = autoSnapshots.find(target, &start);
+    
+    if (!snapshot) {
+        debug(SNP_DEBUG, "No snapshot found for frame %llu\n", target);
+        return false;
+    }
+    
+    debug(SNP_DEBUG, "Seeking frame %llu from frame %llu\n", target, start);
+    
+    suspend();
+    
+    // Skip the snapshot if the current state is closer to the target frame
+    bool result = true;
+    if (frame < start || frame > target || rasterLine != 0 || rasterCycle != 1) {
+        result = loadFromSnapshotUnsafe(snapshot);
+    }
+    
+    // Replay the remaining frames
+    seeking = true;
+    while (result && frame < target) result = executeOneFrame();
+    seeking = false;
+    
+    // Discard the audio samples produced while replaying
+    sid.clearRingbuffer();
+    restartTimer();
+    
+    resume();
+    return result;
+}
+
 void
 C64::deleteSnapshot(vector<Snapshot *> &storage, unsigned index)
 {
@@ -801,7 +1068,7 @@ C64::flash(AnyC64File *file)
         break;
         
         case V64_FILE:
-        loadFromSnapshotUnsafe((Snapshot *)file);
+        result = loadFromSnapshotUnsafe((Snapshot *)file);
         break;
         
         default:
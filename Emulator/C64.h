@@ -20,7 +20,7 @@
 #include "MessageQueue.h"
 
 // Loading and saving
-#include "Snapshot.h"
+#include "RewindBuffer.h"
 #include "T64File.h"
 #include "D64File.h"
 #include "G64File.h"
@@ -162,6 +162,34 @@ class C64 : public HardwareComponent {
      */
     void (VIC::*vicfunc[66])(void);
     
+    //! @brief    Rasterline function table.
+    /*! @details  Stores a pointer to a specialized function executing a
+     *            complete rasterline of the selected VICII model. The table
+     *            is indexed by the power state of both drives (bit 0 = drive 1,
+     *            bit 1 = drive 2).
+     *  @see      executeLine()
+     */
+    bool (C64::*linefunc[4])(void);
+    
+    
+    //
+    // Event scheduling
+    //
+    
+    /*! @brief    Trigger cycles of all event slots
+     *  @details  A component is serviced in all cycles that are greater or
+     *            equal to the trigger cycle of its slot. Components that need
+     *            to be executed every cycle set their trigger cycle to 0.
+     *            Slots without a pending event are set to NEVER.
+     */
+    u64 trigger[EVENT_SLOTS];
+    
+    /*! @brief    Lower bound of all trigger cycles in the first clock phase
+     *  @details  This value is checked once per cycle. Components are only
+     *            touched if this cycle has been reached.
+     */
+    u64 nextTrigger;
+    
     
     //
     // Execution thread
@@ -178,12 +206,6 @@ class C64 : public HardwareComponent {
     
     private:
     
-    /*! @brief    System timer information
-     *  @details  Used to put the emulation thread to sleep for the proper
-     *            amount of time.
-     */
-    mach_timebase_info_data_t timebase;
-    
     /*! @brief    Wake-up time of the synchronization timer in nanoseconds
      *  @details  This value is recomputed each time the emulator thread is
      *            put to sleep.
@@ -242,15 +264,51 @@ class C64 : public HardwareComponent {
      */
     long autoSnapshotInterval = 3;
     
-    //! @brief    Maximum number of stored snapshots
+    //! @brief    Maximum number of stored user snapshots
     static const size_t MAX_SNAPSHOTS = 32;
     
-    //! @brief    Storage for auto-taken snapshots
-    vector<Snapshot *> autoSnapshots;
+    /*! @brief    Storage for auto-taken snapshots
+     *  @details  The number of stored auto-snapshots is limited by the memory
+     *            budget of the rewind buffer.
+     */
+    RewindBuffer autoSnapshots;
+    
+    /*! @brief    Indicates that seekToFrame() is replaying frames
+     *  @details  Auto-snapshots and timing synchronization are disabled
+     *            while replaying.
+     */
+    bool seeking = false;
     
     //! @brief    Storage for user-taken snapshots
     vector<Snapshot *> userSnapshots;
     
+    /*! @brief    Reference snapshot for all newly taken delta snapshots
+     *  @details  A new keyframe is recorded whenever a delta snapshot would
+     *            exceed a quarter of the full snapshot size.
+     */
+    std::shared_ptr<Snapshot> keyframe;
+    
+    /*! @brief    Working buffer for taking delta snapshots
+     *  @details  The buffer holds the state recorded by the latest delta
+     *            snapshot. It is updated incrementally, i.e., components whose
+     *            state has not changed are not serialized again.
+     */
+    Snapshot *scratchSnapshot = NULL;
+    
+    /*! @brief    Pages of scratchSnapshot that may differ from the keyframe
+     *  @details  Only these pages are compared when a delta snapshot is taken.
+     */
+    vector<bool> dirtyPages;
+    
+    /*! @brief    Blobs of the snapshot that is currently being loaded
+     *  @details  NULL if no snapshot is being loaded.
+     *  @seealso  restoreBlob
+     */
+    const BlobList *loadingBlobs = NULL;
+    
+    //! @brief    Indicates that a blob of the loaded snapshot was missing
+    bool missingBlob = false;
+    
     
     //
     //! @functiongroup Constructing and destructing
@@ -394,14 +452,70 @@ class C64 : public HardwareComponent {
      */
     bool executeOneFrame();
     
+    /*! @brief    Executes a certain number of CPU cycles.
+     *  @return   false, if the CPU has been halted, e.g., by a breakpoint.
+     *  @see      executeUntil()
+     */
+    bool executeCycles(u64 count) { return executeUntil(cpu.cycle + count); }
+    
+    /*! @brief    Executes until the CPU cycle counter reaches targetCycle.
+     *  @details  Complete rasterlines are processed by the specialized
+     *            rasterline functions stored in linefunc[]. Only partially
+     *            executed rasterlines at the beginning or at the end are
+     *            processed cycle by cycle.
+     *  @return   false, if the CPU has been halted, e.g., by a breakpoint.
+     */
+    bool executeUntil(u64 targetCycle);
+    
+    
+    //
+    //! @functiongroup Scheduling events
+    //
+    
+    //! @brief    Schedules an event in the specified slot.
+    void scheduleEvent(EventSlot slot, u64 cycle) {
+        trigger[slot] = cycle;
+        if (cycle < nextTrigger) nextTrigger = cycle;
+    }
+    
+    //! @brief    Removes a pending event from the specified slot.
+    void cancelEvent(EventSlot slot) { trigger[slot] = NEVER; }
+    
     private:
     
+    //! @brief    Services all due events in the first clock phase.
+    void serviceEvents(u64 cycle);
+    
     //! @brief    Executes a single CPU cycle
     bool executeOneCycle();
     
     //! @brief    Work horse for executeOneCycle()
     bool _executeOneCycle();
     
+    /*! @brief    Executes a single CPU cycle in a specialized rasterline.
+     *  @details  Does the same as _executeOneCycle(), but the VICII cycle
+     *            function and the drive power states are fixed at compile
+     *            time. Hence, the compiler is able to replace the indirect
+     *            call through vicfunc[] by a direct call and to remove the
+     *            drive power checks.
+     */
+    template <void (VIC::*vicCycle)(), bool drive1On, bool drive2On>
+    bool executeCycle();
+    
+    /*! @brief    Executes a complete rasterline.
+     *  @details  The function is instantiated for each emulated VICII model
+     *            (PAL_6569_R3 also stands for PAL_6569_R1) and each
+     *            combination of drive power states. It calls the cycle
+     *            functions instantiated for the same model.
+     *  @note     The function must be invoked in the first rasterline cycle.
+     *  @see      updateVicFunctionTable()
+     */
+    template <VICModel model, bool drive1On, bool drive2On>
+    bool executeLine();
+    
+    //! @brief    Assigns the cycle and rasterline functions of a VICII model
+    template <VICModel model> void assignVicFunctions();
+    
     //! @brief    Invoked before executing the first cycle of a rasterline
     void beginRasterLine();
     
@@ -416,14 +530,6 @@ class C64 : public HardwareComponent {
     //! @functiongroup Managing the execution thread
     //
     
-    private:
-    
-    //! @brief    Converts kernel time to nanoseconds.
-    u64 abs_to_nanos(u64 abs) { return abs * timebase.numer / timebase.denom; }
-    
-    //! @brief    Converts nanoseconds to kernel time.
-    u64 nanos_to_abs(u64 nanos) { return nanos * timebase.denom / timebase.numer; }
-    
     public:
     
     //! @brief    Updates variable warp and returns the new value.
@@ -444,6 +550,16 @@ class C64 : public HardwareComponent {
     //! @brief    Setter for warpLoad
     void setWarpLoad(bool b);
     
+    /*! @brief    Skips drawing for some frames.
+     *  @details  Out of each period of frames, the first skipped frames are
+     *            emulated without rendering pixels. This speeds up automated
+     *            test runs and fast-forwarding. Call with skipped = 0 to draw
+     *            all frames again.
+     *  @see      VIC::setFrameSkip()
+     */
+    void setFrameSkip(unsigned skipped, unsigned period) {
+        suspend(); vic.setFrameSkip(skipped, period); resume(); }
+    
     /*! @brief    Restarts the synchronization timer.
      *  @details  The function is invoked at launch time to initialize the timer
      *            and reinvoked when the synchronization timer gets out of sync.
@@ -490,18 +606,30 @@ class C64 : public HardwareComponent {
     void setSnapshotInterval(long value) { autoSnapshotInterval = value; }
     
     /*! @brief    Loads the current state from a snapshot file
+     *  @details  If a ROM image or disk referenced by the snapshot is not
+     *            available, the previous state is restored and false is
+     *            returned.
      *  @note     There is an thread-unsafe and thread-safe version of this
      *            function. The first one can be unsed inside the emulator
      *            thread or from outside if the emulator is halted. The second
      *            one can be called any time.
      */
-    void loadFromSnapshotUnsafe(Snapshot *snapshot);
-    void loadFromSnapshotSafe(Snapshot *snapshot);
+    bool loadFromSnapshotUnsafe(Snapshot *snapshot);
+    bool loadFromSnapshotSafe(Snapshot *snapshot);
+    
+    /*! @brief    Copies a blob referenced by the loaded state into a buffer
+     *  @details  Called by components inside didLoadFromBuffer(). The blob is
+     *            taken from the loaded snapshot or, if it is not part of the
+     *            snapshot, from the blob store. If it is not available at all,
+     *            the load fails.
+     *  @seealso  BlobStore::restore
+     */
+    bool restoreBlob(u64 fingerprint, BlobRef &ref, u8 *data, size_t size);
     
     //! @brief    Restores a certain snapshot from the snapshot storage
-    bool restoreSnapshot(vector<Snapshot *> &storage, unsigned nr);
-    bool restoreAutoSnapshot(unsigned nr) { return restoreSnapshot(autoSnapshots, nr); }
-    bool restoreUserSnapshot(unsigned nr) { return restoreSnapshot(userSnapshots, nr); }
+    bool restoreSnapshot(Snapshot *snapshot);
+    bool restoreAutoSnapshot(unsigned nr) { return restoreSnapshot(autoSnapshot(nr)); }
+    bool restoreUserSnapshot(unsigned nr) { return restoreSnapshot(userSnapshot(nr)); }
 
     //! @brief    Restores the latest snapshot from the snapshot storage
     bool restoreLatestAutoSnapshot() { return restoreAutoSnapshot(0); }
@@ -509,14 +637,21 @@ class C64 : public HardwareComponent {
     
     //! @brief    Returns the number of stored snapshots
     size_t numSnapshots(vector<Snapshot *> &storage);
-    size_t numAutoSnapshots() { return numSnapshots(autoSnapshots); }
+    size_t numAutoSnapshots() { return autoSnapshots.count(); }
     size_t numUserSnapshots() { return numSnapshots(userSnapshots); }
     
     //! @brief    Returns an snapshot from the snapshot storage
     Snapshot *getSnapshot(vector<Snapshot *> &storage, unsigned nr);
-    Snapshot *autoSnapshot(unsigned nr) { return getSnapshot(autoSnapshots, nr); }
+    Snapshot *autoSnapshot(unsigned nr) { return autoSnapshots.get(nr); }
     Snapshot *userSnapshot(unsigned nr) { return getSnapshot(userSnapshots, nr); }
     
+    /*! @brief    Takes a delta snapshot
+     *  @details  The returned snapshot only stores the 256 byte pages that
+     *            differ from the current keyframe.
+     *  @seealso  keyframe
+     */
+    Snapshot *makeDeltaSnapshot();
+    
     /*! @brief    Takes a snapshot and inserts it into the snapshot storage
      *  @details  The new snapshot is inserted at position 0 and all others are
      *            moved one position up. If the buffer is full, the oldest
@@ -525,18 +660,42 @@ class C64 : public HardwareComponent {
      *            thread.
      */
     void takeSnapshot(vector<Snapshot *> &storage);
-    void takeAutoSnapshot() { takeSnapshot(autoSnapshots); }
     void takeUserSnapshot() { takeSnapshot(userSnapshots); }
-    void takeAutoSnapshotSafe() { suspend(); takeSnapshot(autoSnapshots); resume(); }
     void takeUserSnapshotSafe() { suspend(); takeSnapshot(userSnapshots); resume(); }
     
+    /*! @brief    Takes a snapshot and records it in the rewind buffer
+     *  @details  Auto-snapshots are stored as delta snapshots.
+     *  @note     Make sure to call the 'Safe' version outside the emulator
+     *            thread.
+     */
+    void takeAutoSnapshot();
+    void takeAutoSnapshotSafe() { suspend(); takeAutoSnapshot(); resume(); }
+    
     /*! @brief    Deletes a snapshot from the snapshot storage
      *  @details  All remaining snapshots are moved one position down.
      */
     void deleteSnapshot(vector<Snapshot *> &storage, unsigned nr);
-    void deleteAutoSnapshot(unsigned nr) { deleteSnapshot(autoSnapshots, nr); }
+    void deleteAutoSnapshot(unsigned nr) { autoSnapshots.remove(nr); }
     void deleteUserSnapshot(unsigned nr) { deleteSnapshot(userSnapshots, nr); }
     
+    //! @brief    Returns the memory budget of the rewind buffer in bytes
+    size_t getRewindBudget() { return autoSnapshots.getBudget(); }
+    
+    //! @brief    Sets the memory budget of the rewind buffer in bytes
+    void setRewindBudget(size_t bytes) {
+        suspend(); autoSnapshots.setBudget(bytes); resume(); }
+    
+    /*! @brief    Moves the emulator to the beginning of a certain frame
+     *  @details  The latest auto-snapshot taken at or before the target frame
+     *            is restored. Afterwards, the emulator is run forward until
+     *            the target frame is reached. Frames are replayed without
+     *            timing synchronization, so the function returns as soon as
+     *            the replay has finished.
+     *  @return   false if no suitable snapshot exists or the replay was
+     *            interrupted, e.g., by a breakpoint.
+     */
+    bool seekToFrame(u64 target);
+    
 
     //
     //! @functiongroup Handling Roms
@@ -17,13 +17,24 @@
 // Snapshot version number
 #define V_MAJOR 3
 #define V_MINOR 3
-#define V_SUBMINOR 0
+#define V_SUBMINOR 2
 
 // Uncomment these settings in a release build
 // #define RELEASEBUILD
 // #define NDEBUG
 
 
+//
+// Performance settings
+//
+
+// Dispatch CPU microinstructions via computed gotos if the compiler supports
+// them. Define NO_COMPUTED_GOTO to fall back to a portable switch statement.
+#if defined(__GNUC__) && !defined(NO_COMPUTED_GOTO)
+#define CPU_COMPUTED_GOTO
+#endif
+
+
 //
 // Debug settings
 //
@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "C64Pool.h"
+#include <unistd.h>
+
+C64Pool::C64Pool(unsigned numWorkers)
+{
+    setDescription("C64Pool");
+
+    if (numWorkers == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        numWorkers = cores > 0 ? (unsigned)cores : 1;
+    }
+
+    // Emulate a tenth of a second per time slice by default
+    sliceCycles = PAL_CYCLES_PER_SECOND / 10;
+
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&workAvailable, NULL);
+    pthread_cond_init(&allDone, NULL);
+
+    for (unsigned i = 0; i < numWorkers; i++) {
+
+        PoolWorker *worker = new PoolWorker();
+        worker->pool = this;
+        worker->nr = i;
+        pthread_mutex_init(&worker->lock, NULL);
+        workers.push_back(worker);
+    }
+
+    // Launch threads after all queues have been set up (workers steal)
+    for (auto worker : workers) {
+        pthread_create(&worker->thread, NULL, threadMain, (void *)worker);
+    }
+
+    debug(RUN_DEBUG, "Created pool with %d workers\n", numWorkers);
+}
+
+C64Pool::~C64Pool()
+{
+    pthread_mutex_lock(&lock);
+    shutdown = true;
+    pthread_cond_broadcast(&workAvailable);
+    pthread_mutex_unlock(&lock);
+
+    for (auto worker : workers) {
+        pthread_join(worker->thread, NULL);
+        pthread_mutex_destroy(&worker->lock);
+        delete worker;
+    }
+
+    pthread_cond_destroy(&allDone);
+    pthread_cond_destroy(&workAvailable);
+    pthread_mutex_destroy(&lock);
+}
+
+void
+C64Pool::submit(C64 *c64, u64 cycles, PoolCallback *callback, void *data)
+{
+    assert(c64 != NULL);
+
+    c64->setAlwaysWarp(true);
+    PoolJob job = { c64, c64->cpu.cycle + cycles, callback, data };
+
+    pthread_mutex_lock(&lock);
+    pending++;
+    PoolWorker *worker = workers[nextWorker];
+    nextWorker = (nextWorker + 1) % workers.size();
+    pthread_mutex_unlock(&lock);
+
+    enqueue(worker, job);
+}
+
+void
+C64Pool::wait()
+{
+    pthread_mutex_lock(&lock);
+    while (pending) {
+        pthread_cond_wait(&allDone, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void
+C64Pool::enqueue(PoolWorker *worker, const PoolJob &job)
+{
+    pthread_mutex_lock(&worker->lock);
+    worker->queue.push_back(job);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_mutex_lock(&lock);
+    queued++;
+    pthread_cond_signal(&workAvailable);
+    pthread_mutex_unlock(&lock);
+}
+
+bool
+C64Pool::dequeue(PoolWorker *worker, PoolJob &job)
+{
+    bool found = false;
+
+    // Check the own queue first
+    pthread_mutex_lock(&worker->lock);
+    if (!worker->queue.empty()) {
+        job = worker->queue.front();
+        worker->queue.pop_front();
+        found = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    // Steal from the other workers, starting with the right neighbour
+    for (unsigned i = 1; !found && i < workers.size(); i++) {
+
+        PoolWorker *victim = workers[(worker->nr + i) % workers.size()];
+
+        pthread_mutex_lock(&victim->lock);
+        if (!victim->queue.empty()) {
+            job = victim->queue.back();
+            victim->queue.pop_back();
+            found = true;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+
+    if (found) {
+        pthread_mutex_lock(&lock);
+        queued--;
+        pthread_mutex_unlock(&lock);
+    }
+
+    return found;
+}
+
+void
+C64Pool::runWorker(PoolWorker *worker)
+{
+    PoolJob job;
+
+    while (1) {
+
+        // Sleep until there is something to do
+        pthread_mutex_lock(&lock);
+        while (!queued && !shutdown) {
+            pthread_cond_wait(&workAvailable, &lock);
+        }
+        bool terminate = shutdown;
+        pthread_mutex_unlock(&lock);
+
+        if (terminate) break;
+
+        // Another worker may have been faster
+        if (!dequeue(worker, job)) continue;
+
+        // Emulate a single time slice
+        C64 *c64 = job.c64;
+        u64 sliceEnd = MIN(job.targetCycle, c64->cpu.cycle + sliceCycles);
+        bool success = c64->executeUntil(sliceEnd);
+
+        if (success && c64->cpu.cycle < job.targetCycle) {
+            enqueue(worker, job);
+            continue;
+        }
+
+        // The job is finished
+        if (job.callback) {
+            job.callback(c64, success, job.data);
+        }
+
+        pthread_mutex_lock(&lock);
+        if (--pending == 0) pthread_cond_broadcast(&allDone);
+        pthread_mutex_unlock(&lock);
+    }
+}
+
+void *
+C64Pool::threadMain(void *worker)
+{
+    PoolWorker *w = (PoolWorker *)worker;
+    w->pool->runWorker(w);
+    return NULL;
+}
@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _C64POOL_INC
+#define _C64POOL_INC
+
+#include "C64.h"
+#include <deque>
+
+class C64Pool;
+
+/*! @brief    Completion handler of a pool job
+ *  @details  The handler is invoked by the worker thread that executed the
+ *            last time slice of the job. success is false if the emulator
+ *            stopped before the cycle budget was used up (e.g., because a
+ *            breakpoint was hit or the CPU jammed).
+ */
+typedef void PoolCallback(C64 *c64, bool success, void *data);
+
+/*! @brief    A single emulation job
+ *  @details  A job runs a C64 instance until the CPU cycle counter reaches
+ *            targetCycle.
+ */
+struct PoolJob {
+
+    C64 *c64;
+    u64 targetCycle;
+    PoolCallback *callback;
+    void *data;
+};
+
+//! @brief    A worker thread together with its job queue
+struct PoolWorker {
+
+    //! @brief    The pool this worker belongs to
+    C64Pool *pool;
+
+    //! @brief    Index of this worker
+    unsigned nr;
+
+    //! @brief    The worker thread
+    pthread_t thread;
+
+    //! @brief    Mutex protecting the job queue
+    pthread_mutex_t lock;
+
+    /*! @brief    The job queue
+     *  @details  The owner takes jobs from the front and puts unfinished jobs
+     *            back at the end. Other workers steal from the end.
+     */
+    std::deque<PoolJob> queue;
+};
+
+/*! @brief    Runs many C64 instances on a fixed number of worker threads
+ *  @details  The pool is meant for unattended batch jobs such as regression
+ *            testing large disk collections. Each submitted instance is
+ *            emulated in warp mode for a given number of CPU cycles. Instead
+ *            of running an instance to completion, workers emulate a time
+ *            slice and put the instance back into their queue. Workers
+ *            running out of work steal jobs from other workers. Hence, the
+ *            load stays balanced even if jobs differ greatly in length.
+ *
+ *            The emulator threads of the submitted instances must not be
+ *            running while they are owned by the pool. Instances must be
+ *            created and configured outside the pool, because some components
+ *            (e.g., reSID) initialize global tables on construction.
+ */
+class C64Pool : public C64Object {
+
+    //! @brief    The worker threads
+    vector<PoolWorker *> workers;
+
+    //! @brief    Mutex protecting the shared state below
+    pthread_mutex_t lock;
+
+    //! @brief    Signals workers that new jobs have been queued
+    pthread_cond_t workAvailable;
+
+    //! @brief    Signals waiting clients that all jobs are completed
+    pthread_cond_t allDone;
+
+    //! @brief    Number of jobs sitting in one of the queues
+    unsigned queued = 0;
+
+    //! @brief    Number of submitted jobs that have not completed yet
+    unsigned pending = 0;
+
+    //! @brief    Set by the destructor to terminate all workers
+    bool shutdown = false;
+
+    //! @brief    Worker receiving the next submitted job
+    unsigned nextWorker = 0;
+
+    //! @brief    Number of CPU cycles emulated in a single time slice
+    u64 sliceCycles;
+
+public:
+
+    /*! @brief    Constructor
+     *  @param    numWorkers is the number of worker threads. If 0 is passed
+     *            in, a worker is created for each available CPU core.
+     */
+    C64Pool(unsigned numWorkers = 0);
+
+    //! @brief    Destructor
+    ~C64Pool();
+
+    //! @brief    Returns the number of worker threads
+    unsigned numWorkers() { return (unsigned)workers.size(); }
+
+    //! @brief    Returns the number of CPU cycles emulated per time slice
+    u64 getSliceCycles() { return sliceCycles; }
+
+    //! @brief    Sets the number of CPU cycles emulated per time slice
+    void setSliceCycles(u64 cycles) { sliceCycles = cycles ? cycles : 1; }
+
+    /*! @brief    Hands over an instance to the pool
+     *  @details  The instance is put into warp mode and emulated for the
+     *            specified number of CPU cycles. Afterwards, the completion
+     *            handler is called. The instance must not be accessed by the
+     *            caller until the completion handler has been invoked.
+     */
+    void submit(C64 *c64, u64 cycles, PoolCallback *callback = NULL, void *data = NULL);
+
+    //! @brief    Blocks until all submitted jobs have been completed
+    void wait();
+
+private:
+
+    //! @brief    The main loop of each worker thread
+    void runWorker(PoolWorker *worker);
+
+    //! @brief    Adds a job at the end of a worker's queue
+    void enqueue(PoolWorker *worker, const PoolJob &job);
+
+    /*! @brief    Fetches the next job for a worker
+     *  @details  The worker's own queue is checked first. If it is empty, the
+     *            function tries to steal a job from the other workers.
+     *  @return   false, if no job has been found
+     */
+    bool dequeue(PoolWorker *worker, PoolJob &job);
+
+    //! @brief    Entry point of the worker threads
+    static void *threadMain(void *worker);
+};
+
+#endif
@@ -80,6 +80,24 @@ static const C64Configuration configurations[] = {
     { NTSC_6567_R56A, false, MOS_6526, false, MOS_6581, false, GLUE_DISCRETE, INIT_PATTERN_C64 }
 };
 
+/*! @brief    Event slots
+ *  @details  Each slot represents a component that is scheduled by the
+ *            C64's cycle scheduler. The order of the slots matches the order
+ *            in which the components are serviced inside a single cycle.
+ *            EVENT_TAPE is serviced in the second clock phase, all other
+ *            slots are serviced in the first clock phase.
+ */
+typedef enum {
+    EVENT_CIA1,
+    EVENT_CIA2,
+    EVENT_IEC,
+    EVENT_TAPE,
+    EVENT_SLOTS
+} EventSlot;
+
+//! @brief    Trigger cycle of an event slot that has no pending event
+#define NEVER UINT64_MAX
+
 /*! @brief    Message types
  *  @details  List of all possible message id's
  */
@@ -152,7 +170,10 @@ typedef enum {
     // Peripherals (Expansion port)
     MSG_CARTRIDGE,
     MSG_NO_CARTRIDGE,
-    MSG_CART_SWITCH
+    MSG_CART_SWITCH,
+    
+    // CPU related messages (continued)
+    MSG_CPU_WATCHPOINT_REACHED
 
 } MessageType;
 
@@ -49,8 +49,8 @@ CIA::CIA(C64 &ref) : C64Component(ref)
         { &CNT,              sizeof(CNT),              CLEAR_ON_RESET },
         { &INT,              sizeof(INT),              CLEAR_ON_RESET },
         { &tiredness,        sizeof(tiredness),        CLEAR_ON_RESET },
-        { &wakeUpCycle,      sizeof(wakeUpCycle),      CLEAR_ON_RESET },
-        { &idleCounter,      sizeof(idleCounter),      CLEAR_ON_RESET },
+        { &sleeping,         sizeof(sleeping),         CLEAR_ON_RESET },
+        { &sleepCycle,       sizeof(sleepCycle),       CLEAR_ON_RESET },
         { NULL,              0,                        0 }};
 
     registerSnapshotItems(items, sizeof(items));
@@ -295,19 +295,19 @@ CIA::spypeek(u16 addr)
             
         case 0x04: // CIA_TIMER_A_LOW
             running = delay & CIACountA3;
-            return LO_BYTE(counterA - (running ? (u16)idleCounter : 0));
+            return LO_BYTE(counterA - (running ? (u16)idleCycles() : 0));
             
         case 0x05: // CIA_TIMER_A_HIGH
             running = delay & CIACountA3;
-            return HI_BYTE(counterA - (running ? (u16)idleCounter : 0));
+            return HI_BYTE(counterA - (running ? (u16)idleCycles() : 0));
             
         case 0x06: // CIA_TIMER_B_LOW
             running = delay & CIACountB3;
-            return LO_BYTE(counterB - (running ? (u16)idleCounter : 0));
+            return LO_BYTE(counterB - (running ? (u16)idleCycles() : 0));
             
         case 0x07: // CIA_TIMER_B_HIGH
             running = delay & CIACountB3;
-            return HI_BYTE(counterB - (running ? (u16)idleCounter : 0));
+            return HI_BYTE(counterB - (running ? (u16)idleCycles() : 0));
             
         case 0x08: // CIA_TIME_OF_DAY_SEC_FRAC
             return tod.getTodTenth();
@@ -757,7 +757,7 @@ CIA::getInfo()
 void
 CIA::executeOneCycle()
 {
-    wakeUp();
+    wakeUp(c64->cpu.cycle - 1);
     
     u64 oldDelay = delay;
     u64 oldFeed  = feed;
@@ -1080,7 +1080,7 @@ CIA::executeOneCycle()
 void
 CIA::sleep()
 {
-    assert(idleCounter == 0);
+    assert(!sleeping);
     
     // Determine maximum possible sleep cycles based on timer counts
     u64 cycle = c64->cpu.cycle;
@@ -1088,33 +1088,46 @@ CIA::sleep()
     u64 sleepB = (counterB > 2) ? (cycle + counterB - 1) : 0;
     
     // CIAs with stopped timers can sleep forever
-    if (!(feed & CIACountA0)) sleepA = UINT64_MAX;
-    if (!(feed & CIACountB0)) sleepB = UINT64_MAX;
+    if (!(feed & CIACountA0)) sleepA = NEVER;
+    if (!(feed & CIACountB0)) sleepB = NEVER;
     
-    wakeUpCycle = MIN(sleepA, sleepB);
-    // setWakeUpCycle(MIN(sleepA, sleepB));
+    sleeping = true;
+    sleepCycle = cycle;
+    c64->scheduleEvent(eventSlot, MIN(sleepA, sleepB));
 }
 
 void
-CIA::wakeUp()
+CIA::wakeUp(u64 targetCycle)
 {
-    // u64 idleCycles = idleCounter;
+    if (!sleeping)
+        return;
     
     // Make up for missed cycles
-    if (idleCounter) {
+    u64 skipped = (targetCycle > sleepCycle) ? targetCycle - sleepCycle : 0;
+    if (skipped) {
         if (feed & CIACountA0) {
-            assert(counterA >= idleCounter);
-            counterA -= idleCounter;
+            assert(counterA >= skipped);
+            counterA -= skipped;
         }
         if (feed & CIACountB0) {
-            assert(counterB >= idleCounter);
-            counterB -= idleCounter;
+            assert(counterB >= skipped);
+            counterB -= skipped;
         }
-        idleCounter = 0;
-        // resetIdleCounter();
     }
-    wakeUpCycle = 0;
-    // setWakeUpCycle(0);
+    sleeping = false;
+    c64->scheduleEvent(eventSlot, 0);
+}
+
+void
+CIA::wakeUp()
+{
+    wakeUp(c64->cpu.cycle);
+}
+
+u64
+CIA::idleCycles()
+{
+    return sleeping ? c64->cpu.cycle - sleepCycle : 0;
 }
 
 
@@ -1125,6 +1138,7 @@ CIA::wakeUp()
 CIA1::CIA1(C64 &ref) : CIA(ref)
 {
     setDescription("CIA1");
+    eventSlot = EVENT_CIA1;
 }
 
 CIA1::~CIA1()
@@ -1264,6 +1278,7 @@ CIA1::updatePB()
 CIA2::CIA2(C64 &ref) : CIA(ref)
 {
     setDescription("CIA2");
+    eventSlot = EVENT_CIA2;
 }
 
 CIA2::~CIA2()
@@ -232,13 +232,16 @@ private:
      */
     u8 tiredness;
 
-public:
+    //! @brief    Indicates if the CIA is currently in idle state
+    bool sleeping;
+    
+    //! @brief    The cycle in which the CIA went into idle state
+    u64 sleepCycle;
     
-    //! @brief    Wakeup cycle
-    u64 wakeUpCycle;
+protected:
     
-    //! @brief    Number of skipped executions
-    u64 idleCounter;
+    //! @brief    The event slot that triggers the execution of this CIA
+    EventSlot eventSlot;
     
 public:	
 	
@@ -419,11 +422,20 @@ public:
     
 private:
     
-    //! @brief    Puts the CIA into idle state.
+    /*! @brief    Puts the CIA into idle state.
+     *  @details  The CIA is removed from the C64's cycle scheduler until one
+     *            of its timers is about to underflow.
+     */
     void sleep();
     
-    //! @brief    Emulates all previously skipped cycles.
+    /*! @brief    Emulates all previously skipped cycles.
+     *  @param    targetCycle is the last cycle that has been skipped.
+     */
+    void wakeUp(u64 targetCycle);
     void wakeUp();
+    
+    //! @brief    Returns the number of skipped cycles.
+    u64 idleCycles();
 };
 
 
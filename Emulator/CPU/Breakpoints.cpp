@@ -0,0 +1,126 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "C64.h"
+
+void
+Breakpoints::clear()
+{
+    breakpoints.clear();
+    watchpoints.clear();
+    update();
+}
+
+bool
+Breakpoints::hasBreakpoint(u16 addr, Breakpoint tag)
+{
+    auto it = breakpoints.find(addr);
+    return it != breakpoints.end() && (it->second.flags & tag);
+}
+
+void
+Breakpoints::setBreakpoint(u16 addr, Breakpoint tag)
+{
+    auto it = breakpoints.find(addr);
+
+    if (it != breakpoints.end()) {
+        it->second.flags |= tag;
+    } else {
+        breakpoints[addr] = Guard { (u8)tag, GuardCondition() };
+    }
+    update();
+}
+
+void
+Breakpoints::setBreakpoint(u16 addr, Breakpoint tag, const GuardCondition &condition)
+{
+    setBreakpoint(addr, tag);
+    breakpoints[addr].condition = condition;
+}
+
+void
+Breakpoints::deleteBreakpoint(u16 addr, Breakpoint tag)
+{
+    auto it = breakpoints.find(addr);
+    if (it == breakpoints.end()) return;
+
+    it->second.flags &= ~tag;
+    if (it->second.flags == NO_BREAKPOINT) breakpoints.erase(it);
+    update();
+}
+
+void
+Breakpoints::checkBreakpoint(u16 addr)
+{
+    auto it = breakpoints.find(addr);
+    if (it == breakpoints.end() || !holds(it->second.condition)) return;
+
+    if (it->second.flags & SOFT_BREAKPOINT) {
+
+        // Soft breakpoints get deleted when reached
+        deleteBreakpoint(addr, SOFT_BREAKPOINT);
+        cpu.setErrorState(CPU_SOFT_BREAKPOINT_REACHED);
+
+    } else {
+
+        cpu.setErrorState(CPU_HARD_BREAKPOINT_REACHED);
+    }
+}
+
+void
+Breakpoints::setWatchpoint(u16 addr, u8 access, const GuardCondition &condition)
+{
+    watchpoints[addr] = Guard { access, condition };
+    update();
+}
+
+void
+Breakpoints::deleteWatchpoint(u16 addr)
+{
+    watchpoints.erase(addr);
+    update();
+}
+
+void
+Breakpoints::checkWatchpoint(u16 addr, WatchAccess access)
+{
+    auto it = watchpoints.find(addr);
+    if (it == watchpoints.end() || !(it->second.flags & access)) return;
+    if (!holds(it->second.condition)) return;
+
+    watchAddr = addr;
+    cpu.setErrorState(CPU_WATCHPOINT_REACHED);
+}
+
+bool
+Breakpoints::holds(const GuardCondition &c)
+{
+    if (c.registers) {
+        if ((c.registers & GUARD_A) && cpu.regA != c.a) return false;
+        if ((c.registers & GUARD_X) && cpu.regX != c.x) return false;
+        if ((c.registers & GUARD_Y) && cpu.regY != c.y) return false;
+        if ((c.registers & GUARD_SP) && cpu.regSP != c.sp) return false;
+    }
+    if (cpu.cycle < c.minCycle || cpu.cycle > c.maxCycle) return false;
+    if (c.rasterLine >= 0 && c64.rasterLine != c.rasterLine) return false;
+    if (c.rasterCycle >= 0 && c64.rasterCycle != c.rasterCycle) return false;
+
+    return true;
+}
+
+void
+Breakpoints::update()
+{
+    armed = !breakpoints.empty() || !watchpoints.empty();
+    watching = !watchpoints.empty();
+    mem->guards = watching ? this : NULL;
+
+    // Skipped loop iterations neither fetch instructions nor access memory
+    if (armed) cpu.leaveIdleLoop();
+}
@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _BREAKPOINTS_INC
+#define _BREAKPOINTS_INC
+
+#include "basic.h"
+#include "CPUTypes.h"
+#include <unordered_map>
+
+class C64;
+class CPU;
+class Memory;
+
+//! @brief    Memory accesses a watchpoint can react to
+typedef enum : u8 {
+    WATCH_READ  = 0x01,
+    WATCH_WRITE = 0x02
+} WatchAccess;
+
+//! @brief    Registers a guard condition can compare
+typedef enum : u8 {
+    GUARD_A  = 0x01,
+    GUARD_X  = 0x02,
+    GUARD_Y  = 0x04,
+    GUARD_SP = 0x08
+} GuardRegister;
+
+/*! @brief    Condition of a breakpoint or watchpoint
+ *  @details  A breakpoint or watchpoint only triggers if all parts of its
+ *            condition hold. The default condition always holds. The raster
+ *            position always refers to the C64, also for the drive CPUs.
+ */
+struct GuardCondition {
+
+    //! @brief    Registers that must hold the specified values
+    u8 registers = 0;
+    u8 a = 0;
+    u8 x = 0;
+    u8 y = 0;
+    u8 sp = 0;
+
+    //! @brief    Range of CPU cycles (inclusive)
+    u64 minCycle = 0;
+    u64 maxCycle = UINT64_MAX;
+
+    //! @brief    Rasterline and rasterline cycle (-1 = any)
+    i16 rasterLine = -1;
+    i16 rasterCycle = -1;
+};
+
+
+/*! @brief    Breakpoints and watchpoints of a single CPU
+ *  @details  Guards are kept in hash tables, so that they cost nothing as
+ *            long as none is set. The CPU only looks up the program counter
+ *            if 'armed' is set. Memory accesses are only reported while a
+ *            watchpoint is set. The CPU then runs its Watched<M>
+ *            instantiation, and the memory holds a pointer to this object.
+ *            A triggered guard puts the CPU into an error state which halts
+ *            the emulator at the next instruction fetch.
+ */
+class Breakpoints {
+
+    //! @brief    A breakpoint or watchpoint
+    struct Guard {
+
+        //! @brief    Breakpoint tags or watched accesses
+        u8 flags;
+
+        //! @brief    Trigger condition
+        GuardCondition condition;
+    };
+
+    //! @brief    The guarded CPU
+    CPU &cpu;
+
+    //! @brief    The machine the CPU belongs to
+    C64 &c64;
+
+    //! @brief    The memory watched by watchpoints
+    Memory *mem;
+
+    //! @brief    All breakpoints by address
+    std::unordered_map<u16, Guard> breakpoints;
+
+    //! @brief    All watchpoints by address
+    std::unordered_map<u16, Guard> watchpoints;
+
+public:
+
+    //! @brief    Indicates if any breakpoint or watchpoint is set
+    bool armed = false;
+
+    //! @brief    Indicates if any watchpoint is set
+    bool watching = false;
+
+    //! @brief    Address of the most recently triggered watchpoint
+    u16 watchAddr = 0;
+
+    //! @brief    Constructor
+    Breakpoints(CPU &cpu, C64 &c64, Memory *mem) : cpu(cpu), c64(c64), mem(mem) { }
+
+    //! @brief    Deletes all breakpoints and watchpoints
+    void clear();
+
+
+    //
+    //! @functiongroup Breakpoints
+    //
+
+    //! @brief    Checks if a breakpoint with the specified tag is set.
+    bool hasBreakpoint(u16 addr, Breakpoint tag);
+
+    //! @brief    Adds a tag to the breakpoint at the specified address.
+    void setBreakpoint(u16 addr, Breakpoint tag);
+
+    //! @brief    Adds a tag and replaces the condition of a breakpoint.
+    void setBreakpoint(u16 addr, Breakpoint tag, const GuardCondition &condition);
+
+    //! @brief    Removes a tag from the breakpoint at the specified address.
+    void deleteBreakpoint(u16 addr, Breakpoint tag);
+
+    /*! @brief    Checks the breakpoint at the program counter
+     *  @details  Called by the CPU after each opcode fetch if 'armed' is set.
+     *            Soft breakpoints are deleted when reached.
+     */
+    void checkBreakpoint(u16 addr);
+
+
+    //
+    //! @functiongroup Watchpoints
+    //
+
+    //! @brief    Checks if a watchpoint is set at the specified address.
+    bool hasWatchpoint(u16 addr) { return watchpoints.count(addr) != 0; }
+
+    /*! @brief    Sets a watchpoint
+     *  @param    access Combination of WatchAccess flags
+     */
+    void setWatchpoint(u16 addr, u8 access,
+                       const GuardCondition &condition = GuardCondition());
+
+    //! @brief    Deletes the watchpoint at the specified address.
+    void deleteWatchpoint(u16 addr);
+
+    //! @brief    Called by the memory on each access while a watchpoint is set.
+    void checkWatchpoint(u16 addr, WatchAccess access);
+
+private:
+
+    //! @brief    Checks if a condition holds in the current CPU state.
+    bool holds(const GuardCondition &condition);
+
+    //! @brief    Updates the armed flag and the memory hook.
+    void update();
+};
+
+#endif
@@ -9,7 +9,8 @@
 
 #include "C64.h"
 
-CPU::CPU(CPUModel model, Memory *mem, C64& ref) : C64Component(ref)
+CPU::CPU(CPUModel model, Memory *mem, C64& ref) :
+C64Component(ref), breakpoints(*this, ref, mem)
 {
     this->model = model;
     this->mem = mem;
@@ -22,16 +23,23 @@ CPU::CPU(CPUModel model, Memory *mem, C64& ref) : C64Component(ref)
 	// Establish callback for each instruction
 	registerInstructions();
 		
-	// Clear all breakpoint tags
-	for (int i = 0; i <  65536; i++) {
-		breakpoint[i] = NO_BREAKPOINT;	
-	}
+    // Idle loops are only skipped by the C64 CPU
+    idleSkipping = true;
+    idleState = IDLE_SEARCHING;
+    idleLoopRejected = -1;
+    idleRetry = false;
+    
+    // Set up the trace buffer
+    if (!traceBuffer.allocate(traceBufferSize)) {
+        panic("Failed to allocate trace buffer (%s)\n", strerror(errno));
+    }
+    readPtr = 0;
     
     // Register snapshot items
     SnapshotItem items[] = {
         
         // Lifetime items
-        { &model,              sizeof(model),        KEEP_ON_RESET },
+        { &this->model,        sizeof(this->model),  KEEP_ON_RESET },
 
          // Internal state
         { &cycle,              sizeof(cycle),        CLEAR_ON_RESET },
@@ -71,13 +79,18 @@ CPU::reset()
 {
     HardwareComponent::reset();
 
+    setP(0);
     setB(1);
 	rdyLine = true;
 	next = fetch;
     levelDetector.clear();
     edgeDetector.clear();
+    irqCycle = UINT64_MAX;
+    nmiCycle = UINT64_MAX;
     
     clearTraceBuffer();
+    idleState = IDLE_SEARCHING;
+    idleLoopRejected = -1;
 }
 
 void 
@@ -120,6 +133,25 @@ CPU::didLoadFromBuffer(u8 **buffer)
 {
     levelDetector.loadFromBuffer(buffer);
     edgeDetector.loadFromBuffer(buffer);
+    
+    setP(regP);
+    
+    // Let the next poll operations check the restored detectors
+    irqCycle = 0;
+    nmiCycle = 0;
+    
+    idleState = IDLE_SEARCHING;
+    idleLoopRejected = -1;
+}
+
+void
+CPU::willSaveToBuffer(u8 **buffer)
+{
+    // Bring the registers up to date without leaving the loop
+    if (idleState == IDLE_SKIPPING) restoreIdleState();
+    
+    // Snapshots store the flags in regP
+    syncP();
 }
 
 void
@@ -156,9 +188,12 @@ CPU::pullDownNmiLine(IntSource bit)
 {
     assert(bit != 0);
     
+    if ((nmiLine | bit) != nmiLine) leaveIdleLoopForInterrupt();
+    
     // Check for falling edge on physical line
     if (!nmiLine) {
         edgeDetector.write(1);
+        nmiCycle = MIN(nmiCycle, cycle + 1);
     }
     
     nmiLine |= bit;
@@ -167,6 +202,7 @@ CPU::pullDownNmiLine(IntSource bit)
 void
 CPU::releaseNmiLine(IntSource source)
 {
+    if (nmiLine & source) leaveIdleLoop();
     nmiLine &= ~source;
 }
 
@@ -175,13 +211,16 @@ CPU::pullDownIrqLine(IntSource source)
 {
 	assert(source != 0);
     
+    if ((irqLine | source) != irqLine) leaveIdleLoopForInterrupt();
 	irqLine |= source;
     levelDetector.write(irqLine);
+    irqCycle = MIN(irqCycle, cycle + 1);
 }
 
 void
 CPU::releaseIrqLine(IntSource source)
 {
+    if (irqLine & source) leaveIdleLoop();
     irqLine &= ~source;
     levelDetector.write(irqLine);
 }
@@ -189,6 +228,8 @@ CPU::releaseIrqLine(IntSource source)
 void
 CPU::setRDY(bool value)
 {
+    leaveIdleLoop();
+    
     if (rdyLine)
     {
         rdyLine = value;
@@ -201,6 +242,156 @@ CPU::setRDY(bool value)
     }
 }
 
+void
+CPU::startIdleRecording()
+{
+    idleState = IDLE_ENTERING;
+    idleLoopStart = regPC;
+    idleCycles = 0;
+}
+
+void
+CPU::recordIdleCycle(bool result)
+{
+    if (!result) {
+        idleState = IDLE_SEARCHING;
+        return;
+    }
+    
+    bool loopStart = next == fetch && regPC == idleLoopStart;
+    
+    switch (idleState) {
+            
+        case IDLE_ENTERING:
+            
+            // Run through the first iteration to get rid of stale latch values
+            if (loopStart) {
+                idleState = IDLE_RECORDING;
+                idleCycles = 0;
+                idleAccesses = c64->mem.sideEffects;
+                idleTraced = traceBuffer.appended();
+            } else if (++idleCycles > maxIdleCycles) {
+                rejectIdleLoop(true);
+            }
+            return;
+            
+        case IDLE_RECORDING:
+            
+            // Record the second iteration
+            if (idleCycles == maxIdleCycles) {
+                rejectIdleLoop();
+                return;
+            }
+            saveMicroState(idleTrace[idleCycles++]);
+            
+            if (loopStart) {
+                idleState = IDLE_VERIFYING;
+                idlePhase = 0;
+            }
+            return;
+            
+        case IDLE_VERIFYING:
+        {
+            // Compare the third iteration with the second one
+            MicroState state;
+            saveMicroState(state);
+            
+            if (memcmp(&state, &idleTrace[idlePhase], sizeof(state)) != 0) {
+                rejectIdleLoop();
+                return;
+            }
+            if (++idlePhase < idleCycles) {
+                return;
+            }
+            
+            // Only loops without side effects can be skipped
+            if (c64->mem.sideEffects != idleAccesses || traceBuffer.appended() != idleTraced) {
+                rejectIdleLoop();
+                return;
+            }
+            
+            debug(CPU_DEBUG, "Skipping idle loop at %04X (%d cycles)\n",
+                  idleLoopStart, idleCycles);
+            idleState = IDLE_SKIPPING;
+            idlePhase = 0;
+            return;
+        }
+            
+        default:
+            assert(false);
+    }
+}
+
+void
+CPU::leaveIdleLoopForInterrupt()
+{
+    leaveIdleLoop();
+    
+    // The interrupt handler may change what a left loop is waiting for
+    if (idleRetry) idleLoopRejected = -1;
+}
+
+void
+CPU::rejectIdleLoop(bool retry)
+{
+    idleLoopRejected = idleLoopStart;
+    idleRetry = retry;
+    idleState = IDLE_SEARCHING;
+}
+
+void
+CPU::restoreIdleState()
+{
+    assert(idleState == IDLE_SKIPPING);
+    assert(idlePhase < idleCycles);
+    
+    // Each iteration ends in the state the next one starts with
+    loadMicroState(idleTrace[(idlePhase + idleCycles - 1) % idleCycles]);
+}
+
+void
+CPU::saveMicroState(MicroState &state)
+{
+    memset(&state, 0, sizeof(state));
+    
+    state.next = next;
+    state.regPC = regPC;
+    state.pc = pc;
+    state.regA = regA;
+    state.regX = regX;
+    state.regY = regY;
+    state.regSP = regSP;
+    syncP();
+    state.regP = regP;
+    state.regADL = regADL;
+    state.regADH = regADH;
+    state.regIDL = regIDL;
+    state.regD = regD;
+    state.overflow = overflow;
+    state.doNmi = doNmi;
+    state.doIrq = doIrq;
+}
+
+void
+CPU::loadMicroState(const MicroState &state)
+{
+    next = state.next;
+    regPC = state.regPC;
+    pc = state.pc;
+    regA = state.regA;
+    regX = state.regX;
+    regY = state.regY;
+    regSP = state.regSP;
+    setP(state.regP);
+    regADL = state.regADL;
+    regADH = state.regADH;
+    regIDL = state.regIDL;
+    regD = state.regD;
+    overflow = state.overflow;
+    doNmi = state.doNmi;
+    doIrq = state.doIrq;
+}
+
 unsigned
 CPU::getLengthOfInstruction(u8 opcode)
 {
@@ -245,6 +436,9 @@ CPU::setErrorState(ErrorState state)
         case CPU_HARD_BREAKPOINT_REACHED:
             c64->putMessage(MSG_CPU_HARD_BREAKPOINT_REACHED);
             return;
+        case CPU_WATCHPOINT_REACHED:
+            c64->putMessage(MSG_CPU_WATCHPOINT_REACHED);
+            return;
         case CPU_ILLEGAL_INSTRUCTION:
             c64->putMessage(MSG_CPU_ILLEGAL_INSTRUCTION);
             return;
@@ -253,55 +447,36 @@ CPU::setErrorState(ErrorState state)
     }
 }
 
-unsigned
-CPU::recordedInstructions()
+bool
+CPU::setTraceFile(const char *path, size_t capacity)
 {
-    return writePtr >= readPtr ? writePtr - readPtr : traceBufferSize + writePtr - readPtr;
+    bool success = path ?
+    traceBuffer.create(path, capacity) : traceBuffer.allocate(traceBufferSize);
+    
+    if (!success) warn("Failed to map trace buffer (%s)\n", strerror(errno));
+    readPtr = 0;
+    return success;
 }
 
-void
-CPU::recordInstruction()
+unsigned
+CPU::recordedInstructions()
 {
-    RecordedInstruction i;
-    u8 opcode = mem->spypeek(pc);
-    unsigned length = getLengthOfInstruction(opcode);
-    
-    i.cycle = cycle;
-    i.pc = pc;
-    i.byte1 = opcode;
-    i.byte2 = length > 1 ? mem->spypeek(i.pc + 1) : 0;
-    i.byte3 = length > 2 ? mem->spypeek(i.pc + 2) : 0;
-    i.a = regA;
-    i.x = regX;
-    i.y = regY;
-    i.sp = regSP;
-    i.flags = getP();
-    
-    assert(writePtr < traceBufferSize);
-
-    traceBuffer[writePtr] = i;
-    writePtr = (writePtr + 1) % traceBufferSize;
-    if (writePtr == readPtr) {
-        readPtr = (readPtr + 1) % traceBufferSize;
-    }
+    if (readPtr < traceBuffer.first()) readPtr = traceBuffer.first();
+    return (unsigned)(traceBuffer.appended() - readPtr);
 }
 
 RecordedInstruction
 CPU::readRecordedInstruction()
 {
     assert(recordedInstructions() != 0);
-    assert(readPtr < traceBufferSize);
     
-    RecordedInstruction result = traceBuffer[readPtr];
-    readPtr = (readPtr + 1) % traceBufferSize;
-    
-    return result;
+    return traceBuffer.get(readPtr++);
 }
 
 RecordedInstruction
 CPU::readRecordedInstruction(unsigned previous)
 {
-    return traceBuffer[(writePtr + traceBufferSize - previous - 1) % traceBufferSize];
+    return traceBuffer.get(traceBuffer.appended() - previous - 1);
 }
 
 
@@ -326,7 +501,7 @@ CPU::disassemble(RecordedInstruction instr, bool hex)
         case ADDR_ZERO_PAGE_Y:
         case ADDR_INDIRECT_X:
         case ADDR_INDIRECT_Y: {
-            u8 value = mem->spypeek(instr.pc + 1);
+            u8 value = instr.byte2;
             hex ? sprint8x(operand, value) : sprint8d(operand, value);
             break;
         }
@@ -335,12 +510,12 @@ CPU::disassemble(RecordedInstruction instr, bool hex)
         case ADDR_ABSOLUTE:
         case ADDR_ABSOLUTE_X:
         case ADDR_ABSOLUTE_Y: {
-            u16 value = LO_HI(mem->spypeek(instr.pc + 1),mem->spypeek(instr.pc + 2));
+            u16 value = LO_HI(instr.byte2, instr.byte3);
             hex ? sprint16x(operand, value) : sprint16d(operand, value);
             break;
         }
         case ADDR_RELATIVE: {
-            u16 value = instr.pc + 2 + (i8)mem->spypeek(instr.pc + 1);
+            u16 value = instr.pc + 2 + (i8)instr.byte2;
             hex ? sprint16x(operand, value) : sprint16d(operand, value);
             break;
         }
@@ -14,9 +14,13 @@
 
 #include "CPUTypes.h"
 #include "CPUInstructions.h"
+#include "TraceBuffer.h"
+#include "Breakpoints.h"
 #include "TimeDelayed.h"
 
 class Memory;
+class C64Memory;
+template <class M> class Watched;
 
 /*! @class  The virtual 6502 / 6510 processor
  */
@@ -92,9 +96,16 @@ class CPU : public C64Component {
      */
     AddressingMode addressingMode[256];
     
-    //! @brief    Breakpoint tag for each memory cell
-    u8 breakpoint[65536];
-
+    
+    //
+    // Breakpoints
+    //
+    
+    public:
+    
+    //! @brief    Breakpoints and watchpoints
+    Breakpoints breakpoints;
+    
     
     //
     // Internal state
@@ -142,9 +153,19 @@ class CPU : public C64Component {
     /*! @brief     Processor status register (flags)
      *  @details   7 6 5 4 3 2 1 0
      *             N O - B D I Z C
+     *             The N and Z bits are only valid after calling syncP().
      */
     u8 regP;
     
+    /*! @brief    Lazily evaluated Negative and Zero flag
+     *  @details  Most instructions set N and Z from the same result. Instead
+     *            of computing both bits, the result is stored and the flags
+     *            are extracted when needed. N is bit 7 of valN and Z is set
+     *            iff valZ equals 0.
+     */
+    u8 valN;
+    u8 valZ;
+    
 	//! @brief    Address data (low byte)
 	u8 regADL;
     
@@ -266,24 +287,103 @@ class CPU : public C64Component {
      */
     bool doIrq;
     
+    /*! @brief    First cycle in which the level detector can report an IRQ
+     *  @details  The output of the level detector can only change when the
+     *            IRQ line changes. Pulling down the line schedules the cycle
+     *            in which the low level shows up on the output. Until then,
+     *            polling is a single comparison. Once the detector is
+     *            low again on both ends, the value is reset to UINT64_MAX.
+     */
+    u64 irqCycle;
+    
+    //! @brief    First cycle in which the edge detector can report an NMI
+    u64 nmiCycle;
+    
     
     //
     // Trace buffer
     //
     
-    //! @brief  Trace buffer size
+    //! @brief  Default trace buffer size
     static const unsigned traceBufferSize = 1024;
     
     //! @brief  Ring buffer for storing the CPU state
-    RecordedInstruction traceBuffer[traceBufferSize];
-    
-    //! @brief  Trace buffer read pointer
-    unsigned readPtr;
+    TraceBuffer traceBuffer;
     
-    //! @brief  Trace buffer write pointer
-    unsigned writePtr;
+    //! @brief  Index of the first unread record in the trace buffer
+    u64 readPtr;
 
     
+    //
+    // Idle loop detection
+    //
+    
+    //! @brief    Maximum length of a skippable loop in bytes
+    static const u16 maxIdleBytes = 64;
+    
+    //! @brief    Maximum number of cycles per iteration of a skippable loop
+    static const unsigned maxIdleCycles = 32;
+    
+    //! @brief    States of the idle loop detector
+    typedef enum : u8 {
+        IDLE_SEARCHING,
+        IDLE_ENTERING,
+        IDLE_RECORDING,
+        IDLE_VERIFYING,
+        IDLE_SKIPPING
+    } IdleState;
+    
+    /*! @brief    Registers and latches that may change inside a loop
+     *  @details  Instances are cleared before they are filled. Hence, two
+     *            states can be compared with memcmp.
+     */
+    typedef struct {
+        
+        MicroInstruction next;
+        u16 regPC;
+        u16 pc;
+        u8 regA, regX, regY, regSP, regP;
+        u8 regADL, regADH, regIDL, regD;
+        bool overflow, doNmi, doIrq;
+        
+    } MicroState;
+    
+    /*! @brief    Indicates whether idle loops are skipped
+     *  @seealso  executeC64Cycle()
+     */
+    bool idleSkipping;
+    
+    //! @brief    Current state of the idle loop detector
+    IdleState idleState;
+    
+    //! @brief    Start address of the loop under observation
+    u16 idleLoopStart;
+    
+    //! @brief    Start address of the most recently rejected loop
+    i32 idleLoopRejected;
+    
+    /*! @brief    Indicates whether the rejected loop deserves another chance
+     *  @details  Set if the loop has been left before it could be recorded.
+     *            Such a loop is observed again after the next interrupt.
+     */
+    bool idleRetry;
+    
+    //! @brief    CPU state after each cycle of the recorded loop iteration
+    MicroState idleTrace[maxIdleCycles];
+    
+    //! @brief    Number of cycles of a single loop iteration
+    unsigned idleCycles;
+    
+    //! @brief    Number of cycles executed in the current loop iteration
+    unsigned idlePhase;
+    
+    //! @brief    Memory side effect counter when recording started
+    u64 idleAccesses;
+    
+    //! @brief    Number of traced instructions when recording started
+    u64 idleTraced;
+    
+    
     //
     //! @functiongroup Constructing and destructing
     //
@@ -327,6 +427,7 @@ class CPU : public C64Component {
 	void dump();	
     size_t stateSize();
     void didLoadFromBuffer(u8 **buffer);
+    void willSaveToBuffer(u8 **buffer);
     void didSaveToBuffer(u8 **buffer);
     
     
@@ -352,13 +453,14 @@ class CPU : public C64Component {
     u16 getPC() { return pc; }
     
     //! @brief    Redirects the CPU to a new instruction in memory.
-    void jumpToAddress(u16 addr) { pc = regPC = addr; next = fetch; }
+    void jumpToAddress(u16 addr) {
+        leaveIdleLoop(); pc = regPC = addr; next = fetch; }
 
 	//! @brief    Returns N_FLAG, if Negative flag is set, 0 otherwise.
-    u8 getN() { return regP & N_FLAG; }
+    u8 getN() { return valN & N_FLAG; }
     
     //! @brief    0: Negative-flag is cleared, any other value: flag is set.
-    void setN(u8 bit) { bit ? regP |= N_FLAG : regP &= ~N_FLAG; }
+    void setN(u8 bit) { valN = bit ? N_FLAG : 0; }
     
 	//! @brief    Returns V_FLAG, if Overflow flag is set, 0 otherwise.
     u8 getV() { return regP & V_FLAG; }
@@ -385,10 +487,13 @@ class CPU : public C64Component {
     void setI(u8 bit) { bit ? regP |= I_FLAG : regP &= ~I_FLAG; }
     
 	//! @brief    Returns Z_FLAG, if Zero flag is set, 0 otherwise.
-    u8 getZ() { return regP & Z_FLAG; }
+    u8 getZ() { return valZ ? 0 : Z_FLAG; }
     
     //! @brief    0: Zero-flag is cleared, any other value: flag is set.
-    void setZ(u8 bit) { bit ? regP |= Z_FLAG : regP &= ~Z_FLAG; }
+    void setZ(u8 bit) { valZ = !bit; }
+    
+    //! @brief    Sets the Negative- and the Zero-flag according to a result.
+    void setNZ(u8 value) { valN = valZ = value; }
     
 	//! @brief    Returns C_FLAG, if Carry flag is set, 0 otherwise.
     u8 getC() { return regP & C_FLAG; }
@@ -402,7 +507,7 @@ class CPU : public C64Component {
 	 *  @details  Each bit in the status register corresponds to the value of
      *            a single flag, except bit 5 which is always set.
      */
-    u8 getP() { return regP | 0b00100000; }
+    u8 getP() { syncP(); return regP | 0b00100000; }
 
 	/*! @brief    Returns the status register without the B flag
 	 *  @details  The bit position of the B flag is always 0. This function is
@@ -413,10 +518,13 @@ class CPU : public C64Component {
     u8 getPWithClearedB() { return getP() & 0b11101111; }
     
     //! @brief    Writes a value to the status register.
-    void setP(u8 p) { regP = p; }
+    void setP(u8 p) { regP = p; valN = p; valZ = ~p & Z_FLAG; }
     
     //! @brief    Writes a value to the status register without overwriting B.
-    void setPWithoutB(u8 p) { regP = (p & 0b11101111) | (regP & 0b00010000); }
+    void setPWithoutB(u8 p) { setP((p & 0b11101111) | (regP & 0b00010000)); }
+    
+    //! @brief    Writes the lazily evaluated flags back into regP.
+    void syncP() { regP = (regP & ~(N_FLAG | Z_FLAG)) | getN() | getZ(); }
     
 	//! @brief    Changes low byte of the program counter only.
     void setPCL(u8 lo) { regPC = (regPC & 0xff00) | lo; }
@@ -438,13 +546,13 @@ class CPU : public C64Component {
     void incPCH(u8 offset = 1) { setPCH(HI_BYTE(regPC) + offset); }
 	
 	//! @brief    Loads the accumulator. The Z- and N-flag may change.
-    void loadA(u8 a) { regA = a; setN(a & 0x80); setZ(a == 0); }
+    void loadA(u8 a) { regA = a; setNZ(a); }
 
 	//! @brief    Loads the X register. The Z- and N-flag may change.
-    void loadX(u8 x) { regX = x; setN(x & 0x80); setZ(x == 0); }
+    void loadX(u8 x) { regX = x; setNZ(x); }
     
 	//! @brief    Loads the Y register. The Z- and N-flag may change.
-    void loadY(u8 y) { regY = y; setN(y & 0x80); setZ(y == 0); }
+    void loadY(u8 y) { regY = y; setNZ(y); }
     
     
     //
@@ -462,6 +570,23 @@ class CPU : public C64Component {
     u8 ror(u8 op);
     u8 rol(u8 op);
     
+    //! @brief    Applies an entry of a decimal mode lookup table.
+    void loadDecimalResult(u16 entry);
+    
+    public:
+    
+    /*! @brief    Computes ADC and SBC in decimal mode digit by digit
+     *  @details  The decimal mode lookup tables are generated with these
+     *            functions. They reproduce the NMOS 6502 behaviour for
+     *            invalid BCD numbers, too.
+     *  @return   The new accumulator in the low byte and the N, V, Z and C
+     *            flag at their status register positions in the high byte.
+     */
+    static u16 adcDecimal(u8 a, u8 op, u8 carry);
+    static u16 sbcDecimal(u8 a, u8 op, u8 carry);
+    
+    private:
+    
     
     //
     //! @functiongroup Handling interrupts
@@ -491,12 +616,37 @@ class CPU : public C64Component {
     
 	//! @brief    Sets the RDY line.
     void setRDY(bool value);
+    
+    private:
+    
+    /*! @brief    Polls the level detector of the IRQ line
+     *  @details  Only called once irqCycle has been reached.
+     */
+    bool pollIrq() {
+        u8 level = levelDetector.delayed();
+        if (!level && !levelDetector.current()) irqCycle = UINT64_MAX;
+        return level && !getI();
+    }
+    
+    /*! @brief    Polls the edge detector of the NMI line
+     *  @details  Only called once nmiCycle has been reached.
+     */
+    bool pollNmi() {
+        u8 edge = edgeDetector.delayed();
+        if (!edge && !edgeDetector.current()) nmiCycle = UINT64_MAX;
+        return edge;
+    }
+    
+    public:
 		
     
     //
     //! @functiongroup Examining the currently executed instruction
     //
         
+    //! @brief    Returns the addressing mode of an instruction.
+    AddressingMode getAddressingMode(u8 opcode) { return addressingMode[opcode]; }
+    
 	/*! @brief    Returns the length of an instruction in bytes.
 	 *  @result   Integer value between 1 and 3.
      */
@@ -531,10 +681,103 @@ class CPU : public C64Component {
     //
     
 	/*! @brief    Executes the next micro instruction.
+     *  @details  The function is specialized on the memory class the CPU is
+     *            connected to (C64Memory or VC1541Memory). Hence, all memory
+     *            accesses are resolved at compile time.
+     *  @note     Instructions are not translated into larger blocks. VICII
+     *            runs between any two CPU cycles, reads the RAM the CPU
+     *            writes to, and may stall the CPU on each read. Hence, a
+     *            translated block would have to be split into single cycles
+     *            again. Caching only the decoded opcodes gains nothing
+     *            measurable either, because an opcode fetch from RAM or ROM
+     *            is a single inline table lookup. Loops that wait for an
+     *            interrupt are handled by executeC64Cycle() instead.
 	 *  @return   true, if the micro instruction was processed successfully.
      *            false, if the CPU was halted, e.g., by reaching a breakpoint.
      */
-    bool executeOneCycle();
+    template <class M> bool executeOneCycle();
+    
+    /*! @brief    Executes the next micro instruction with watchpoints in mind
+     *  @details  Runs executeOneCycle<Watched<M>>() while a watchpoint is set
+     *            and executeOneCycle<M>() otherwise. Only the watched
+     *            instantiation reports memory accesses to the watchpoints.
+     */
+    template <class M> bool executeCycle() {
+        if (likely(!breakpoints.watching)) return executeOneCycle<M>();
+        return executeOneCycle<Watched<M>>();
+    }
+    
+    /*! @brief    Executes the next micro instruction of the C64 CPU
+     *  @details  Works like executeCycle<C64Memory>(), but watches out for
+     *            loops that do nothing but wait for an interrupt. If two
+     *            consecutive iterations of a loop pass through the same
+     *            states without touching I/O space, all further iterations
+     *            are bound to do the same. From then on, the CPU only counts
+     *            cycles. The registers are restored from the recorded
+     *            iteration as soon as anything can break the loop, e.g., an
+     *            interrupt, the RDY line, or a change of the memory layout.
+     */
+    bool executeC64Cycle() {
+        
+        if (idleState == IDLE_SKIPPING) {
+            if (++idlePhase == idleCycles) idlePhase = 0;
+            return true;
+        }
+        
+        bool result = executeCycle<C64Memory>();
+        
+        if (unlikely(idleState != IDLE_SEARCHING)) {
+            recordIdleCycle(result);
+        } else if (next == fetch && (u16)(pc - regPC) < maxIdleBytes) {
+            if (regPC != idleLoopRejected && idleSkipping && rdyLine && !breakpoints.armed) {
+                startIdleRecording();
+            }
+        }
+        return result;
+    }
+    
+    //! @brief    Returns true if idle loops are skipped.
+    bool idleSkippingEnabled() { return idleSkipping; }
+    
+    //! @brief    Enables or disables skipping of idle loops.
+    void setIdleSkipping(bool b) { leaveIdleLoop(); idleSkipping = b; }
+    
+    /*! @brief    Stops observing or skipping the current loop
+     *  @details  If the loop is being skipped, all registers are brought up
+     *            to date. Must be called before anything happens that can
+     *            make the loop take a different path.
+     */
+    void leaveIdleLoop() {
+        if (idleState == IDLE_SKIPPING) restoreIdleState();
+        idleState = IDLE_SEARCHING;
+    }
+    
+    private:
+    
+    //! @brief    Starts recording a loop iteration at the current position.
+    void startIdleRecording();
+    
+    //! @brief    Records or verifies a single cycle of a loop iteration.
+    void recordIdleCycle(bool result);
+    
+    /*! @brief    Stops observing a loop that turned out to be no idle loop.
+     *  @param    retry Observe the loop again after the next interrupt.
+     */
+    void rejectIdleLoop(bool retry = false);
+    
+    //! @brief    Leaves the current loop when an interrupt is requested.
+    void leaveIdleLoopForInterrupt();
+    
+    //! @brief    Restores the registers of a skipped loop.
+    void restoreIdleState();
+    
+    //! @brief    Stores all registers that may change inside a loop.
+    void saveMicroState(MicroState &state);
+    
+    //! @brief    Restores all registers that may change inside a loop.
+    void loadMicroState(const MicroState &state);
+    
+    public:
     
 	//! @brief    Returns the current error state.
     ErrorState getErrorState() { return errorState; }
@@ -551,28 +794,30 @@ class CPU : public C64Component {
     //
     
     //! @brief    Checks if a hard breakpoint is set at the provided address.
-    bool hardBreakpoint(u16 addr) { return (breakpoint[addr] & HARD_BREAKPOINT) != 0; }
+    bool hardBreakpoint(u16 addr) { return breakpoints.hasBreakpoint(addr, HARD_BREAKPOINT); }
     
 	//! @brief    Sets a hard breakpoint at the provided address.
-    void setHardBreakpoint(u16 addr) { breakpoint[addr] |= HARD_BREAKPOINT; }
+    void setHardBreakpoint(u16 addr) { breakpoints.setBreakpoint(addr, HARD_BREAKPOINT); }
 	
 	//! @brief    Deletes a hard breakpoint at the provided address.
-	void deleteHardBreakpoint(u16 addr) { breakpoint[addr] &= ~HARD_BREAKPOINT; }
+	void deleteHardBreakpoint(u16 addr) { breakpoints.deleteBreakpoint(addr, HARD_BREAKPOINT); }
 	
 	//! @brief    Sets or deletes a hard breakpoint at the provided address.
-	void toggleHardBreakpoint(u16 addr) { breakpoint[addr] ^= HARD_BREAKPOINT; }
+	void toggleHardBreakpoint(u16 addr) {
+        hardBreakpoint(addr) ? deleteHardBreakpoint(addr) : setHardBreakpoint(addr); }
     
     //! @brief    Checks if a soft breakpoint is set at the provided address.
-    bool softBreakpoint(u16 addr) { return (breakpoint[addr] & SOFT_BREAKPOINT) != 0; }
+    bool softBreakpoint(u16 addr) { return breakpoints.hasBreakpoint(addr, SOFT_BREAKPOINT); }
 
 	//! @brief    Sets a soft breakpoint at the provided address.
-	void setSoftBreakpoint(u16 addr) { breakpoint[addr] |= SOFT_BREAKPOINT; }
+	void setSoftBreakpoint(u16 addr) { breakpoints.setBreakpoint(addr, SOFT_BREAKPOINT); }
     
 	//! @brief    Deletes a soft breakpoint at the specified address.
-	void deleteSoftBreakpoint(u16 addr) { breakpoint[addr] &= ~SOFT_BREAKPOINT; }
+	void deleteSoftBreakpoint(u16 addr) { breakpoints.deleteBreakpoint(addr, SOFT_BREAKPOINT); }
     
 	//! @brief    Sets or deletes a hard breakpoint at the specified address.
-	void toggleSoftBreakpoint(u16 addr) { breakpoint[addr] ^= SOFT_BREAKPOINT; }
+	void toggleSoftBreakpoint(u16 addr) {
+        softBreakpoint(addr) ? deleteSoftBreakpoint(addr) : setSoftBreakpoint(addr); }
     
     
     //
@@ -580,13 +825,27 @@ class CPU : public C64Component {
     //
     
     //! @brief  Clears the trace buffer.
-    void clearTraceBuffer() { readPtr = writePtr = 0; }
+    void clearTraceBuffer() { traceBuffer.clear(); readPtr = 0; }
+    
+    /*! @brief   Records into a file instead of anonymous memory
+     *  @details The file is overwritten and keeps the latest 'capacity'
+     *           instructions. It stays readable if the emulator crashes and
+     *           can be decoded with TraceBuffer::load(). Passing NULL returns
+     *           to the default trace buffer.
+     */
+    bool setTraceFile(const char *path, size_t capacity);
     
     //! @brief   Returns the number of recorded instructions.
     unsigned recordedInstructions(); 
     
-    //! @brief   Records an instruction.
-    void recordInstruction();
+    /*! @brief   Records the instruction that has just been fetched.
+     *  @details The caller passes in the opcode and the two bytes following
+     *           it, no matter how long the instruction is.
+     */
+    void recordInstruction(u8 byte1, u8 byte2, u8 byte3) {
+        traceBuffer.append(cycle, pc, byte1, byte2, byte3,
+                           regA, regX, regY, regSP, getP());
+    }
     
     /*! @brief   Reads and removes a recorded instruction from the trace buffer.
      *  @note    The trace buffer must not be empty.
@@ -9,6 +9,88 @@
 
 #include "C64.h"
 
+/* Decimal mode lookup tables
+ *
+ * Each table covers all combinations of the accumulator and the operand for
+ * a fixed carry bit. An entry is indexed by (A << 8 | operand). The low byte
+ * holds the new accumulator value, the high byte holds the N, V, Z and C flag
+ * at their bit positions in the status register. The tables are computed at
+ * program start with CPU::adcDecimal() and CPU::sbcDecimal(). They are not
+ * evaluated at compile time, because 256K table entries would exceed the
+ * constant expression step limits of the compilers.
+ */
+
+u16
+CPU::adcDecimal(u8 a, u8 op, u8 carry)
+{
+    u16 sum       = a + op + carry;
+    u8  highDigit = (a >> 4) + (op >> 4);
+    u8  lowDigit  = (a & 0x0F) + (op & 0x0F) + carry;
+    u8  flags     = 0;
+    
+    // If an overflow occurs on a BCD digit, it needs to be fixed by adding the pseudo-tetrade 0110 (=6)
+    if (lowDigit > 9) {
+        lowDigit = lowDigit + 6;
+    }
+    if (lowDigit > 0x0F) {
+        highDigit++;
+    }
+    
+    if ((sum & 0xFF) == 0) flags |= CPU::Z_FLAG;
+    if (highDigit & 0x08) flags |= CPU::N_FLAG;
+    if ((((highDigit << 4) ^ a) & 0x80) && !((a ^ op) & 0x80)) flags |= CPU::V_FLAG;
+    
+    if (highDigit > 9) {
+        highDigit = (highDigit + 6);
+    }
+    if (highDigit > 0x0F) flags |= CPU::C_FLAG;
+    
+    return (u16)(flags << 8) | (u8)((highDigit << 4) | (lowDigit & 0x0F));
+}
+
+u16
+CPU::sbcDecimal(u8 a, u8 op, u8 carry)
+{
+    u16 sum       = a - op - (carry ? 0 : 1);
+    u8  highDigit = (a >> 4) - (op >> 4);
+    u8  lowDigit  = (a & 0x0F) - (op & 0x0F) - (carry ? 0 : 1);
+    u8  flags     = 0;
+    
+    // If an underflow occurs on a BCD digit, it needs to be fixed by subtracting the pseudo-tetrade 0110 (=6)
+    if (lowDigit & 0x10) {
+        lowDigit = lowDigit - 6;
+        highDigit--;
+    }
+    if (highDigit & 0x10) {
+        highDigit = highDigit - 6;
+    }
+    
+    if (sum < 0x100) flags |= CPU::C_FLAG;
+    if (((a ^ sum) & 0x80) && ((a ^ op) & 0x80)) flags |= CPU::V_FLAG;
+    if (sum & 0x80) flags |= CPU::N_FLAG;
+    if ((sum & 0xFF) == 0) flags |= CPU::Z_FLAG;
+    
+    return (u16)(flags << 8) | (u8)((highDigit << 4) | (lowDigit & 0x0F));
+}
+
+static struct DecimalTables {
+    
+    //! @brief    Results of ADC and SBC, indexed by the carry bit
+    u16 adc[2][65536];
+    u16 sbc[2][65536];
+    
+    DecimalTables() {
+        
+        for (unsigned carry = 0; carry < 2; carry++) {
+            for (unsigned i = 0; i < 65536; i++) {
+                adc[carry][i] = CPU::adcDecimal(i >> 8, i & 0xFF, carry);
+                sbc[carry][i] = CPU::sbcDecimal(i >> 8, i & 0xFF, carry);
+            }
+        }
+    }
+    
+} decimalTables;
+
 void
 CPU::adc(u8 op)
 {
@@ -31,34 +113,7 @@ CPU::adc_binary(u8 op)
 void
 CPU::adc_bcd(u8 op)
 {
-    u16 sum       = regA + op + (getC() ? 1 : 0);
-    u8  highDigit = (regA >> 4) + (op >> 4);
-    u8  lowDigit  = (regA & 0x0F) + (op & 0x0F) + (getC() ? 1 : 0);
-    
-    // Check for overflow conditions
-    // If an overflow occurs on a BCD digit, it needs to be fixed by adding the pseudo-tetrade 0110 (=6)
-    if (lowDigit > 9) {
-        lowDigit = lowDigit + 6;
-    }
-    if (lowDigit > 0x0F) {
-        highDigit++;
-    }
-    
-    setZ((sum & 0xFF) == 0);
-    setN(highDigit & 0x08);
-    setV((((highDigit << 4) ^ regA) & 0x80) && !((regA ^ op) & 0x80));
-    
-    if (highDigit > 9) {
-        highDigit = (highDigit + 6);
-    }
-    if (highDigit > 0x0F) {
-        setC(1);
-    } else {
-        setC(0);
-    }
-    
-    lowDigit &= 0x0F;
-    regA = (u8)((highDigit << 4) | lowDigit);
+    loadDecimalResult(decimalTables.adc[getC() ? 1 : 0][regA << 8 | op]);
 }
 
 void
@@ -67,8 +122,7 @@ CPU::cmp(u8 op1, u8 op2)
     u8 tmp = op1 - op2;
     
     setC(op1 >= op2);
-    setN(tmp & 128);
-    setZ(tmp == 0);
+    setNZ(tmp);
 }
 
 void
@@ -93,26 +147,19 @@ CPU::sbc_binary(u8 op)
 void
 CPU::sbc_bcd(u8 op)
 {
-    u16 sum       = regA - op - (getC() ? 0 : 1);
-    u8  highDigit = (regA >> 4) - (op >> 4);
-    u8  lowDigit  = (regA & 0x0F) - (op & 0x0F) - (getC() ? 0 : 1);
-    
-    // Check for underflow conditions
-    // If an overflow occurs on a BCD digit, it needs to be fixed by subtracting the pseudo-tetrade 0110 (=6)
-    if (lowDigit & 0x10) {
-        lowDigit = lowDigit - 6;
-        highDigit--;
-    }
-    if (highDigit & 0x10) {
-        highDigit = highDigit - 6;
-    }
-    
-    setC(sum < 0x100);
-    setV(((regA ^ sum) & 0x80) && ((regA ^ op) & 0x80));
-    setZ((sum & 0xFF) == 0);
-    setN(sum & 0x80);
+    loadDecimalResult(decimalTables.sbc[getC() ? 1 : 0][regA << 8 | op]);
+}
+
+void
+CPU::loadDecimalResult(u16 entry)
+{
+    u8 flags = HI_BYTE(entry);
     
-    regA = (u8)((highDigit << 4) | (lowDigit & 0x0f));
+    setN(flags & N_FLAG);
+    setV(flags & V_FLAG);
+    setZ(flags & Z_FLAG);
+    setC(flags & C_FLAG);
+    regA = LO_BYTE(entry);
 }
 
 void 
@@ -439,14 +486,28 @@ CPU::registerIllegalInstructions()
     registerCallback(0x9B, "TAS*", ADDR_ABSOLUTE_Y, TAS_abs_y);
 }
 
-bool
+template <class M> bool
 CPU::executeOneCycle()
 {
+    // Access memory through the concrete class to avoid virtual calls
+    typename MemoryView<M>::Type mem = MemoryView<M>::bind(this->mem);
     u8 instr;
     
+#ifdef CPU_COMPUTED_GOTO
+    
+    // Jump directly to the label of the next microinstruction
+    static void *const dispatch[] = {
+#define X(name) &&name##_label,
+        MICRO_INSTRUCTIONS(X)
+#undef X
+    };
+    goto *dispatch[next];
+    
+#endif
+    
     switch (next) {
             
-        case fetch:
+        MICRO(fetch)
             
             /* DEBUG */
             /*
@@ -491,7 +552,9 @@ CPU::executeOneCycle()
             // Disassemble command if requested
             if (unlikely(tracingEnabled())) {
   
-                recordInstruction();
+                // For RAM and ROM, spypeek() resolves the address like the
+                // opcode fetch above, i.e., with an inline table lookup
+                recordInstruction(instr, mem->spypeek(pc + 1), mem->spypeek(pc + 2));
             
                 /*
                 RecordedInstruction recorded = readRecordedInstruction(0);
@@ -514,16 +577,9 @@ CPU::executeOneCycle()
             }
             
             
-            // Check breakpoint tag
-            if (unlikely(breakpoint[pc] != NO_BREAKPOINT)) {
-                if (breakpoint[pc] & SOFT_BREAKPOINT) {
-                    // Soft breakpoints get deleted when reached
-                    breakpoint[pc] &= ~SOFT_BREAKPOINT;
-                    setErrorState(CPU_SOFT_BREAKPOINT_REACHED);
-                } else {
-                    setErrorState(CPU_HARD_BREAKPOINT_REACHED);
-                }
-                debug(CPU_DEBUG, "Breakpoint reached\n");
+            // Check breakpoints
+            if (unlikely(breakpoints.armed)) {
+                breakpoints.checkBreakpoint(pc);
             }
             
             return errorState == CPU_OK;
@@ -532,12 +588,12 @@ CPU::executeOneCycle()
         // Illegal instructions
         //
             
-        case JAM:
+        MICRO(JAM)
             
             setErrorState(CPU_ILLEGAL_INSTRUCTION);
             CONTINUE
 
-        case JAM_2:
+        MICRO(JAM_2)
             POLL_INT
             DONE
 
@@ -545,17 +601,17 @@ CPU::executeOneCycle()
         // IRQ handling
         //
             
-        case irq_2:
+        MICRO(irq_2)
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case irq_3:
+        MICRO(irq_3)
             
             PUSH_PCH
             CONTINUE
             
-        case irq_4:
+        MICRO(irq_4)
             
             PUSH_PCL
             // Check for interrupt hijacking
@@ -569,19 +625,19 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case irq_5:
+        MICRO(irq_5)
             
             mem->poke(0x100+(regSP--), getPWithClearedB());
             CONTINUE
             
-        case irq_6:
+        MICRO(irq_6)
             
             READ_FROM(0xFFFE)
             setPCL(regD);
             setI(1);
             CONTINUE
             
-        case irq_7:
+        MICRO(irq_7)
             
             READ_FROM(0xFFFF)
             setPCH(regD);
@@ -591,34 +647,34 @@ CPU::executeOneCycle()
         // NMI handling
         // 
         
-        case nmi_2:
+        MICRO(nmi_2)
 
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case nmi_3:
+        MICRO(nmi_3)
             
             PUSH_PCH
             CONTINUE
             
-        case nmi_4:
+        MICRO(nmi_4)
             
             PUSH_PCL
             CONTINUE
             
-        case nmi_5:
+        MICRO(nmi_5)
             
             mem->poke(0x100+(regSP--), getPWithClearedB());
             CONTINUE
             
-        case nmi_6:
+        MICRO(nmi_6)
             
             READ_FROM(0xFFFA)
             setPCL(regD);
             setI(1);
             CONTINUE
             
-        case nmi_7:
+        MICRO(nmi_7)
 
             READ_FROM(0xFFFB)
             setPCH(regD);
@@ -632,7 +688,7 @@ CPU::executeOneCycle()
         // Adressing mode: Immediate (shared behavior)
         //
 
-        case BRK: case RTI: case RTS:
+        MICRO(BRK) MICRO(RTI) MICRO(RTS)
             
             IDLE_READ_IMMEDIATE
             CONTINUE
@@ -641,7 +697,7 @@ CPU::executeOneCycle()
         // Adressing mode: Implied (shared behavior)
         //
 
-        case PHA: case PHP: case PLA: case PLP:
+        MICRO(PHA) MICRO(PHP) MICRO(PLA) MICRO(PLP)
             
             IDLE_READ_IMPLIED
             CONTINUE
@@ -650,21 +706,21 @@ CPU::executeOneCycle()
         // Adressing mode: Zero-Page  (shared behavior)
         //
         
-        case ADC_zpg: case AND_zpg: case ASL_zpg: case BIT_zpg:
-        case CMP_zpg: case CPX_zpg: case CPY_zpg: case DEC_zpg:
-        case EOR_zpg: case INC_zpg: case LDA_zpg: case LDX_zpg:
-        case LDY_zpg: case LSR_zpg: case NOP_zpg: case ORA_zpg:
-        case ROL_zpg: case ROR_zpg: case SBC_zpg: case STA_zpg:
-        case STX_zpg: case STY_zpg: case DCP_zpg: case ISC_zpg:
-        case LAX_zpg: case RLA_zpg: case RRA_zpg: case SAX_zpg:
-        case SLO_zpg: case SRE_zpg:
+        MICRO(ADC_zpg) MICRO(AND_zpg) MICRO(ASL_zpg) MICRO(BIT_zpg)
+        MICRO(CMP_zpg) MICRO(CPX_zpg) MICRO(CPY_zpg) MICRO(DEC_zpg)
+        MICRO(EOR_zpg) MICRO(INC_zpg) MICRO(LDA_zpg) MICRO(LDX_zpg)
+        MICRO(LDY_zpg) MICRO(LSR_zpg) MICRO(NOP_zpg) MICRO(ORA_zpg)
+        MICRO(ROL_zpg) MICRO(ROR_zpg) MICRO(SBC_zpg) MICRO(STA_zpg)
+        MICRO(STX_zpg) MICRO(STY_zpg) MICRO(DCP_zpg) MICRO(ISC_zpg)
+        MICRO(LAX_zpg) MICRO(RLA_zpg) MICRO(RRA_zpg) MICRO(SAX_zpg)
+        MICRO(SLO_zpg) MICRO(SRE_zpg)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_zpg_2: case DEC_zpg_2: case INC_zpg_2: case LSR_zpg_2:
-        case ROL_zpg_2: case ROR_zpg_2: case DCP_zpg_2: case ISC_zpg_2:
-        case RLA_zpg_2: case RRA_zpg_2: case SLO_zpg_2: case SRE_zpg_2:
+        MICRO(ASL_zpg_2) MICRO(DEC_zpg_2) MICRO(INC_zpg_2) MICRO(LSR_zpg_2)
+        MICRO(ROL_zpg_2) MICRO(ROR_zpg_2) MICRO(DCP_zpg_2) MICRO(ISC_zpg_2)
+        MICRO(RLA_zpg_2) MICRO(RRA_zpg_2) MICRO(SLO_zpg_2) MICRO(SRE_zpg_2)
             
             READ_FROM_ZERO_PAGE
             CONTINUE
@@ -673,38 +729,38 @@ CPU::executeOneCycle()
         // Adressing mode: Zero-Page Indexed (shared behavior)
         //
             
-        case ADC_zpg_x: case AND_zpg_x: case ASL_zpg_x: case CMP_zpg_x:
-        case DEC_zpg_x: case EOR_zpg_x: case INC_zpg_x: case LDA_zpg_x:
-        case LDY_zpg_x: case LSR_zpg_x: case NOP_zpg_x: case ORA_zpg_x:
-        case ROL_zpg_x: case ROR_zpg_x: case SBC_zpg_x: case STA_zpg_x:
-        case STY_zpg_x: case DCP_zpg_x: case ISC_zpg_x: case RLA_zpg_x:
-        case RRA_zpg_x: case SLO_zpg_x: case SRE_zpg_x:
+        MICRO(ADC_zpg_x) MICRO(AND_zpg_x) MICRO(ASL_zpg_x) MICRO(CMP_zpg_x)
+        MICRO(DEC_zpg_x) MICRO(EOR_zpg_x) MICRO(INC_zpg_x) MICRO(LDA_zpg_x)
+        MICRO(LDY_zpg_x) MICRO(LSR_zpg_x) MICRO(NOP_zpg_x) MICRO(ORA_zpg_x)
+        MICRO(ROL_zpg_x) MICRO(ROR_zpg_x) MICRO(SBC_zpg_x) MICRO(STA_zpg_x)
+        MICRO(STY_zpg_x) MICRO(DCP_zpg_x) MICRO(ISC_zpg_x) MICRO(RLA_zpg_x)
+        MICRO(RRA_zpg_x) MICRO(SLO_zpg_x) MICRO(SRE_zpg_x)
           
-        case LDX_zpg_y: case STX_zpg_y: case LAX_zpg_y: case SAX_zpg_y:
+        MICRO(LDX_zpg_y) MICRO(STX_zpg_y) MICRO(LAX_zpg_y) MICRO(SAX_zpg_y)
             
             FETCH_ADDR_LO
             CONTINUE
            
-        case ADC_zpg_x_2: case AND_zpg_x_2: case ASL_zpg_x_2: case CMP_zpg_x_2:
-        case DEC_zpg_x_2: case EOR_zpg_x_2: case INC_zpg_x_2: case LDA_zpg_x_2:
-        case LDY_zpg_x_2: case LSR_zpg_x_2: case NOP_zpg_x_2: case ORA_zpg_x_2:
-        case ROL_zpg_x_2: case ROR_zpg_x_2: case SBC_zpg_x_2: case DCP_zpg_x_2:
-        case ISC_zpg_x_2: case RLA_zpg_x_2: case RRA_zpg_x_2: case SLO_zpg_x_2:
-        case SRE_zpg_x_2: case STA_zpg_x_2: case STY_zpg_x_2:
+        MICRO(ADC_zpg_x_2) MICRO(AND_zpg_x_2) MICRO(ASL_zpg_x_2) MICRO(CMP_zpg_x_2)
+        MICRO(DEC_zpg_x_2) MICRO(EOR_zpg_x_2) MICRO(INC_zpg_x_2) MICRO(LDA_zpg_x_2)
+        MICRO(LDY_zpg_x_2) MICRO(LSR_zpg_x_2) MICRO(NOP_zpg_x_2) MICRO(ORA_zpg_x_2)
+        MICRO(ROL_zpg_x_2) MICRO(ROR_zpg_x_2) MICRO(SBC_zpg_x_2) MICRO(DCP_zpg_x_2)
+        MICRO(ISC_zpg_x_2) MICRO(RLA_zpg_x_2) MICRO(RRA_zpg_x_2) MICRO(SLO_zpg_x_2)
+        MICRO(SRE_zpg_x_2) MICRO(STA_zpg_x_2) MICRO(STY_zpg_x_2)
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
         
-        case LDX_zpg_y_2: case LAX_zpg_y_2: case STX_zpg_y_2: case SAX_zpg_y_2:
+        MICRO(LDX_zpg_y_2) MICRO(LAX_zpg_y_2) MICRO(STX_zpg_y_2) MICRO(SAX_zpg_y_2)
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
            
-        case ASL_zpg_x_3: case DEC_zpg_x_3: case INC_zpg_x_3: case LSR_zpg_x_3:
-        case ROL_zpg_x_3: case ROR_zpg_x_3: case DCP_zpg_x_3: case ISC_zpg_x_3:
-        case RLA_zpg_x_3: case RRA_zpg_x_3: case SLO_zpg_x_3: case SRE_zpg_x_3:
+        MICRO(ASL_zpg_x_3) MICRO(DEC_zpg_x_3) MICRO(INC_zpg_x_3) MICRO(LSR_zpg_x_3)
+        MICRO(ROL_zpg_x_3) MICRO(ROR_zpg_x_3) MICRO(DCP_zpg_x_3) MICRO(ISC_zpg_x_3)
+        MICRO(RLA_zpg_x_3) MICRO(RRA_zpg_x_3) MICRO(SLO_zpg_x_3) MICRO(SRE_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             CONTINUE
@@ -714,33 +770,33 @@ CPU::executeOneCycle()
         // Adressing mode: Absolute (shared behavior)
         //
             
-        case ADC_abs: case AND_abs: case ASL_abs: case BIT_abs:
-        case CMP_abs: case CPX_abs: case CPY_abs: case DEC_abs:
-        case EOR_abs: case INC_abs: case LDA_abs: case LDX_abs:
-        case LDY_abs: case LSR_abs: case NOP_abs: case ORA_abs:
-        case ROL_abs: case ROR_abs: case SBC_abs: case STA_abs:
-        case STX_abs: case STY_abs: case DCP_abs: case ISC_abs:
-        case LAX_abs: case RLA_abs: case RRA_abs: case SAX_abs:
-        case SLO_abs: case SRE_abs:
+        MICRO(ADC_abs) MICRO(AND_abs) MICRO(ASL_abs) MICRO(BIT_abs)
+        MICRO(CMP_abs) MICRO(CPX_abs) MICRO(CPY_abs) MICRO(DEC_abs)
+        MICRO(EOR_abs) MICRO(INC_abs) MICRO(LDA_abs) MICRO(LDX_abs)
+        MICRO(LDY_abs) MICRO(LSR_abs) MICRO(NOP_abs) MICRO(ORA_abs)
+        MICRO(ROL_abs) MICRO(ROR_abs) MICRO(SBC_abs) MICRO(STA_abs)
+        MICRO(STX_abs) MICRO(STY_abs) MICRO(DCP_abs) MICRO(ISC_abs)
+        MICRO(LAX_abs) MICRO(RLA_abs) MICRO(RRA_abs) MICRO(SAX_abs)
+        MICRO(SLO_abs) MICRO(SRE_abs)
             
             FETCH_ADDR_LO
             CONTINUE
            
-        case ADC_abs_2: case AND_abs_2: case ASL_abs_2: case BIT_abs_2:
-        case CMP_abs_2: case CPX_abs_2: case CPY_abs_2: case DEC_abs_2:
-        case EOR_abs_2: case INC_abs_2: case LDA_abs_2: case LDX_abs_2:
-        case LDY_abs_2: case LSR_abs_2: case NOP_abs_2: case ORA_abs_2:
-        case ROL_abs_2: case ROR_abs_2: case SBC_abs_2: case STA_abs_2:
-        case STX_abs_2: case STY_abs_2: case DCP_abs_2: case ISC_abs_2:
-        case LAX_abs_2: case RLA_abs_2: case RRA_abs_2: case SAX_abs_2:
-        case SLO_abs_2: case SRE_abs_2:
+        MICRO(ADC_abs_2) MICRO(AND_abs_2) MICRO(ASL_abs_2) MICRO(BIT_abs_2)
+        MICRO(CMP_abs_2) MICRO(CPX_abs_2) MICRO(CPY_abs_2) MICRO(DEC_abs_2)
+        MICRO(EOR_abs_2) MICRO(INC_abs_2) MICRO(LDA_abs_2) MICRO(LDX_abs_2)
+        MICRO(LDY_abs_2) MICRO(LSR_abs_2) MICRO(NOP_abs_2) MICRO(ORA_abs_2)
+        MICRO(ROL_abs_2) MICRO(ROR_abs_2) MICRO(SBC_abs_2) MICRO(STA_abs_2)
+        MICRO(STX_abs_2) MICRO(STY_abs_2) MICRO(DCP_abs_2) MICRO(ISC_abs_2)
+        MICRO(LAX_abs_2) MICRO(RLA_abs_2) MICRO(RRA_abs_2) MICRO(SAX_abs_2)
+        MICRO(SLO_abs_2) MICRO(SRE_abs_2)
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ASL_abs_3: case DEC_abs_3: case INC_abs_3: case LSR_abs_3:
-        case ROL_abs_3: case ROR_abs_3: case DCP_abs_3: case ISC_abs_3:
-        case RLA_abs_3: case RRA_abs_3: case SLO_abs_3: case SRE_abs_3:
+        MICRO(ASL_abs_3) MICRO(DEC_abs_3) MICRO(INC_abs_3) MICRO(LSR_abs_3)
+        MICRO(ROL_abs_3) MICRO(ROR_abs_3) MICRO(DCP_abs_3) MICRO(ISC_abs_3)
+        MICRO(RLA_abs_3) MICRO(RRA_abs_3) MICRO(SLO_abs_3) MICRO(SRE_abs_3)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -749,63 +805,63 @@ CPU::executeOneCycle()
         // Adressing mode: Absolute Indexed (shared behavior)
         //
             
-        case ADC_abs_x: case AND_abs_x: case ASL_abs_x: case CMP_abs_x:
-        case DEC_abs_x: case EOR_abs_x: case INC_abs_x: case LDA_abs_x:
-        case LDY_abs_x: case LSR_abs_x: case NOP_abs_x: case ORA_abs_x:
-        case ROL_abs_x: case ROR_abs_x: case SBC_abs_x: case STA_abs_x:
-        case DCP_abs_x: case ISC_abs_x: case RLA_abs_x: case RRA_abs_x:
-        case SHY_abs_x: case SLO_abs_x: case SRE_abs_x:
+        MICRO(ADC_abs_x) MICRO(AND_abs_x) MICRO(ASL_abs_x) MICRO(CMP_abs_x)
+        MICRO(DEC_abs_x) MICRO(EOR_abs_x) MICRO(INC_abs_x) MICRO(LDA_abs_x)
+        MICRO(LDY_abs_x) MICRO(LSR_abs_x) MICRO(NOP_abs_x) MICRO(ORA_abs_x)
+        MICRO(ROL_abs_x) MICRO(ROR_abs_x) MICRO(SBC_abs_x) MICRO(STA_abs_x)
+        MICRO(DCP_abs_x) MICRO(ISC_abs_x) MICRO(RLA_abs_x) MICRO(RRA_abs_x)
+        MICRO(SHY_abs_x) MICRO(SLO_abs_x) MICRO(SRE_abs_x)
             
-        case ADC_abs_y: case AND_abs_y: case CMP_abs_y: case EOR_abs_y:
-        case LDA_abs_y: case LDX_abs_y: case LSR_abs_y: case ORA_abs_y:
-        case SBC_abs_y: case STA_abs_y: case DCP_abs_y: case ISC_abs_y:
-        case LAS_abs_y: case LAX_abs_y: case RLA_abs_y: case RRA_abs_y:
-        case SHA_abs_y: case SHX_abs_y: case SLO_abs_y: case SRE_abs_y:
-        case TAS_abs_y:
+        MICRO(ADC_abs_y) MICRO(AND_abs_y) MICRO(CMP_abs_y) MICRO(EOR_abs_y)
+        MICRO(LDA_abs_y) MICRO(LDX_abs_y) MICRO(LSR_abs_y) MICRO(ORA_abs_y)
+        MICRO(SBC_abs_y) MICRO(STA_abs_y) MICRO(DCP_abs_y) MICRO(ISC_abs_y)
+        MICRO(LAS_abs_y) MICRO(LAX_abs_y) MICRO(RLA_abs_y) MICRO(RRA_abs_y)
+        MICRO(SHA_abs_y) MICRO(SHX_abs_y) MICRO(SLO_abs_y) MICRO(SRE_abs_y)
+        MICRO(TAS_abs_y)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_abs_x_2: case AND_abs_x_2: case ASL_abs_x_2: case CMP_abs_x_2:
-        case DEC_abs_x_2: case EOR_abs_x_2: case INC_abs_x_2: case LDA_abs_x_2:
-        case LDY_abs_x_2: case LSR_abs_x_2: case NOP_abs_x_2: case ORA_abs_x_2:
-        case ROL_abs_x_2: case ROR_abs_x_2: case SBC_abs_x_2: case STA_abs_x_2:
-        case DCP_abs_x_2: case ISC_abs_x_2: case RLA_abs_x_2: case RRA_abs_x_2:
-        case SHY_abs_x_2: case SLO_abs_x_2: case SRE_abs_x_2:
+        MICRO(ADC_abs_x_2) MICRO(AND_abs_x_2) MICRO(ASL_abs_x_2) MICRO(CMP_abs_x_2)
+        MICRO(DEC_abs_x_2) MICRO(EOR_abs_x_2) MICRO(INC_abs_x_2) MICRO(LDA_abs_x_2)
+        MICRO(LDY_abs_x_2) MICRO(LSR_abs_x_2) MICRO(NOP_abs_x_2) MICRO(ORA_abs_x_2)
+        MICRO(ROL_abs_x_2) MICRO(ROR_abs_x_2) MICRO(SBC_abs_x_2) MICRO(STA_abs_x_2)
+        MICRO(DCP_abs_x_2) MICRO(ISC_abs_x_2) MICRO(RLA_abs_x_2) MICRO(RRA_abs_x_2)
+        MICRO(SHY_abs_x_2) MICRO(SLO_abs_x_2) MICRO(SRE_abs_x_2)
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ADC_abs_y_2: case AND_abs_y_2: case CMP_abs_y_2: case EOR_abs_y_2:
-        case LDA_abs_y_2: case LDX_abs_y_2: case LSR_abs_y_2: case ORA_abs_y_2:
-        case SBC_abs_y_2: case STA_abs_y_2: case DCP_abs_y_2: case ISC_abs_y_2:
-        case LAS_abs_y_2: case LAX_abs_y_2: case RLA_abs_y_2: case RRA_abs_y_2:
-        case SHA_abs_y_2: case SHX_abs_y_2: case SLO_abs_y_2: case SRE_abs_y_2:
-        case TAS_abs_y_2:
+        MICRO(ADC_abs_y_2) MICRO(AND_abs_y_2) MICRO(CMP_abs_y_2) MICRO(EOR_abs_y_2)
+        MICRO(LDA_abs_y_2) MICRO(LDX_abs_y_2) MICRO(LSR_abs_y_2) MICRO(ORA_abs_y_2)
+        MICRO(SBC_abs_y_2) MICRO(STA_abs_y_2) MICRO(DCP_abs_y_2) MICRO(ISC_abs_y_2)
+        MICRO(LAS_abs_y_2) MICRO(LAX_abs_y_2) MICRO(RLA_abs_y_2) MICRO(RRA_abs_y_2)
+        MICRO(SHA_abs_y_2) MICRO(SHX_abs_y_2) MICRO(SLO_abs_y_2) MICRO(SRE_abs_y_2)
+        MICRO(TAS_abs_y_2)
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case ASL_abs_x_3: case DEC_abs_x_3: case INC_abs_x_3: case LSR_abs_x_3:
-        case ROL_abs_x_3: case ROR_abs_x_3: case DCP_abs_x_3: case ISC_abs_x_3:
-        case RLA_abs_x_3: case RRA_abs_x_3: case STA_abs_x_3: case SLO_abs_x_3:
-        case SRE_abs_x_3:
+        MICRO(ASL_abs_x_3) MICRO(DEC_abs_x_3) MICRO(INC_abs_x_3) MICRO(LSR_abs_x_3)
+        MICRO(ROL_abs_x_3) MICRO(ROR_abs_x_3) MICRO(DCP_abs_x_3) MICRO(ISC_abs_x_3)
+        MICRO(RLA_abs_x_3) MICRO(RRA_abs_x_3) MICRO(STA_abs_x_3) MICRO(SLO_abs_x_3)
+        MICRO(SRE_abs_x_3)
         
-        case LSR_abs_y_3: case STA_abs_y_3: case DCP_abs_y_3: case ISC_abs_y_3:
-        case RLA_abs_y_3: case RRA_abs_y_3: case SLO_abs_y_3: case SRE_abs_y_3:
+        MICRO(LSR_abs_y_3) MICRO(STA_abs_y_3) MICRO(DCP_abs_y_3) MICRO(ISC_abs_y_3)
+        MICRO(RLA_abs_y_3) MICRO(RRA_abs_y_3) MICRO(SLO_abs_y_3) MICRO(SRE_abs_y_3)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ASL_abs_x_4: case DEC_abs_x_4: case INC_abs_x_4: case LSR_abs_x_4:
-        case ROL_abs_x_4: case ROR_abs_x_4: case DCP_abs_x_4: case ISC_abs_x_4:
-        case RLA_abs_x_4: case RRA_abs_x_4: case SLO_abs_x_4: case SRE_abs_x_4:
+        MICRO(ASL_abs_x_4) MICRO(DEC_abs_x_4) MICRO(INC_abs_x_4) MICRO(LSR_abs_x_4)
+        MICRO(ROL_abs_x_4) MICRO(ROR_abs_x_4) MICRO(DCP_abs_x_4) MICRO(ISC_abs_x_4)
+        MICRO(RLA_abs_x_4) MICRO(RRA_abs_x_4) MICRO(SLO_abs_x_4) MICRO(SRE_abs_x_4)
             
-        case DCP_abs_y_4: case LSR_abs_y_4: case ISC_abs_y_4: case RLA_abs_y_4:
-        case RRA_abs_y_4: case SLO_abs_y_4: case SRE_abs_y_4:
+        MICRO(DCP_abs_y_4) MICRO(LSR_abs_y_4) MICRO(ISC_abs_y_4) MICRO(RLA_abs_y_4)
+        MICRO(RRA_abs_y_4) MICRO(SLO_abs_y_4) MICRO(SRE_abs_y_4)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -814,50 +870,50 @@ CPU::executeOneCycle()
         // Adressing mode: Indexed Indirect (shared behavior)
         //
     
-        case ADC_ind_x: case AND_ind_x: case ASL_ind_x: case CMP_ind_x:
-        case DEC_ind_x: case EOR_ind_x: case INC_ind_x: case LDA_ind_x:
-        case LDX_ind_x: case LDY_ind_x: case LSR_ind_x: case ORA_ind_x:
-        case ROL_ind_x: case ROR_ind_x: case SBC_ind_x: case STA_ind_x:
-        case DCP_ind_x: case ISC_ind_x: case LAX_ind_x: case RLA_ind_x:
-        case RRA_ind_x: case SAX_ind_x: case SLO_ind_x: case SRE_ind_x:
+        MICRO(ADC_ind_x) MICRO(AND_ind_x) MICRO(ASL_ind_x) MICRO(CMP_ind_x)
+        MICRO(DEC_ind_x) MICRO(EOR_ind_x) MICRO(INC_ind_x) MICRO(LDA_ind_x)
+        MICRO(LDX_ind_x) MICRO(LDY_ind_x) MICRO(LSR_ind_x) MICRO(ORA_ind_x)
+        MICRO(ROL_ind_x) MICRO(ROR_ind_x) MICRO(SBC_ind_x) MICRO(STA_ind_x)
+        MICRO(DCP_ind_x) MICRO(ISC_ind_x) MICRO(LAX_ind_x) MICRO(RLA_ind_x)
+        MICRO(RRA_ind_x) MICRO(SAX_ind_x) MICRO(SLO_ind_x) MICRO(SRE_ind_x)
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ADC_ind_x_2: case AND_ind_x_2: case ASL_ind_x_2: case CMP_ind_x_2:
-        case DEC_ind_x_2: case EOR_ind_x_2: case INC_ind_x_2: case LDA_ind_x_2:
-        case LDX_ind_x_2: case LDY_ind_x_2: case LSR_ind_x_2: case ORA_ind_x_2:
-        case ROL_ind_x_2: case ROR_ind_x_2: case SBC_ind_x_2: case STA_ind_x_2:
-        case DCP_ind_x_2: case ISC_ind_x_2: case LAX_ind_x_2: case RLA_ind_x_2:
-        case RRA_ind_x_2: case SAX_ind_x_2: case SLO_ind_x_2: case SRE_ind_x_2:
+        MICRO(ADC_ind_x_2) MICRO(AND_ind_x_2) MICRO(ASL_ind_x_2) MICRO(CMP_ind_x_2)
+        MICRO(DEC_ind_x_2) MICRO(EOR_ind_x_2) MICRO(INC_ind_x_2) MICRO(LDA_ind_x_2)
+        MICRO(LDX_ind_x_2) MICRO(LDY_ind_x_2) MICRO(LSR_ind_x_2) MICRO(ORA_ind_x_2)
+        MICRO(ROL_ind_x_2) MICRO(ROR_ind_x_2) MICRO(SBC_ind_x_2) MICRO(STA_ind_x_2)
+        MICRO(DCP_ind_x_2) MICRO(ISC_ind_x_2) MICRO(LAX_ind_x_2) MICRO(RLA_ind_x_2)
+        MICRO(RRA_ind_x_2) MICRO(SAX_ind_x_2) MICRO(SLO_ind_x_2) MICRO(SRE_ind_x_2)
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_3: case AND_ind_x_3: case ASL_ind_x_3: case CMP_ind_x_3:
-        case DEC_ind_x_3: case EOR_ind_x_3: case INC_ind_x_3: case LDA_ind_x_3:
-        case LDX_ind_x_3: case LDY_ind_x_3: case LSR_ind_x_3: case ORA_ind_x_3:
-        case ROL_ind_x_3: case ROR_ind_x_3: case SBC_ind_x_3: case STA_ind_x_3:
-        case DCP_ind_x_3: case ISC_ind_x_3: case LAX_ind_x_3: case RLA_ind_x_3:
-        case RRA_ind_x_3: case SAX_ind_x_3: case SLO_ind_x_3: case SRE_ind_x_3:
+        MICRO(ADC_ind_x_3) MICRO(AND_ind_x_3) MICRO(ASL_ind_x_3) MICRO(CMP_ind_x_3)
+        MICRO(DEC_ind_x_3) MICRO(EOR_ind_x_3) MICRO(INC_ind_x_3) MICRO(LDA_ind_x_3)
+        MICRO(LDX_ind_x_3) MICRO(LDY_ind_x_3) MICRO(LSR_ind_x_3) MICRO(ORA_ind_x_3)
+        MICRO(ROL_ind_x_3) MICRO(ROR_ind_x_3) MICRO(SBC_ind_x_3) MICRO(STA_ind_x_3)
+        MICRO(DCP_ind_x_3) MICRO(ISC_ind_x_3) MICRO(LAX_ind_x_3) MICRO(RLA_ind_x_3)
+        MICRO(RRA_ind_x_3) MICRO(SAX_ind_x_3) MICRO(SLO_ind_x_3) MICRO(SRE_ind_x_3)
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_4: case AND_ind_x_4: case ASL_ind_x_4: case CMP_ind_x_4:
-        case DEC_ind_x_4: case EOR_ind_x_4: case INC_ind_x_4: case LDA_ind_x_4:
-        case LDX_ind_x_4: case LDY_ind_x_4: case LSR_ind_x_4: case ORA_ind_x_4:
-        case ROL_ind_x_4: case ROR_ind_x_4: case SBC_ind_x_4: case STA_ind_x_4:
-        case DCP_ind_x_4: case ISC_ind_x_4: case LAX_ind_x_4: case RLA_ind_x_4:
-        case RRA_ind_x_4: case SAX_ind_x_4: case SLO_ind_x_4: case SRE_ind_x_4:
+        MICRO(ADC_ind_x_4) MICRO(AND_ind_x_4) MICRO(ASL_ind_x_4) MICRO(CMP_ind_x_4)
+        MICRO(DEC_ind_x_4) MICRO(EOR_ind_x_4) MICRO(INC_ind_x_4) MICRO(LDA_ind_x_4)
+        MICRO(LDX_ind_x_4) MICRO(LDY_ind_x_4) MICRO(LSR_ind_x_4) MICRO(ORA_ind_x_4)
+        MICRO(ROL_ind_x_4) MICRO(ROR_ind_x_4) MICRO(SBC_ind_x_4) MICRO(STA_ind_x_4)
+        MICRO(DCP_ind_x_4) MICRO(ISC_ind_x_4) MICRO(LAX_ind_x_4) MICRO(RLA_ind_x_4)
+        MICRO(RRA_ind_x_4) MICRO(SAX_ind_x_4) MICRO(SLO_ind_x_4) MICRO(SRE_ind_x_4)
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ASL_ind_x_5: case DEC_ind_x_5: case INC_ind_x_5: case LSR_ind_x_5:
-        case ROL_ind_x_5: case ROR_ind_x_5: case DCP_ind_x_5: case ISC_ind_x_5:
-        case RLA_ind_x_5: case RRA_ind_x_5: case SLO_ind_x_5: case SRE_ind_x_5:
+        MICRO(ASL_ind_x_5) MICRO(DEC_ind_x_5) MICRO(INC_ind_x_5) MICRO(LSR_ind_x_5)
+        MICRO(ROL_ind_x_5) MICRO(ROR_ind_x_5) MICRO(DCP_ind_x_5) MICRO(ISC_ind_x_5)
+        MICRO(RLA_ind_x_5) MICRO(RRA_ind_x_5) MICRO(SLO_ind_x_5) MICRO(SRE_ind_x_5)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -866,43 +922,43 @@ CPU::executeOneCycle()
         // Adressing mode: Indirect Indexed (shared behavior)
         //
             
-        case ADC_ind_y: case AND_ind_y: case CMP_ind_y: case EOR_ind_y:
-        case LDA_ind_y: case LDX_ind_y: case LDY_ind_y: case LSR_ind_y:
-        case ORA_ind_y: case SBC_ind_y: case STA_ind_y: case DCP_ind_y:
-        case ISC_ind_y: case LAX_ind_y: case RLA_ind_y: case RRA_ind_y:
-        case SHA_ind_y: case SLO_ind_y: case SRE_ind_y:
+        MICRO(ADC_ind_y) MICRO(AND_ind_y) MICRO(CMP_ind_y) MICRO(EOR_ind_y)
+        MICRO(LDA_ind_y) MICRO(LDX_ind_y) MICRO(LDY_ind_y) MICRO(LSR_ind_y)
+        MICRO(ORA_ind_y) MICRO(SBC_ind_y) MICRO(STA_ind_y) MICRO(DCP_ind_y)
+        MICRO(ISC_ind_y) MICRO(LAX_ind_y) MICRO(RLA_ind_y) MICRO(RRA_ind_y)
+        MICRO(SHA_ind_y) MICRO(SLO_ind_y) MICRO(SRE_ind_y)
             
             FETCH_POINTER_ADDR
             CONTINUE
            
-        case ADC_ind_y_2: case AND_ind_y_2: case CMP_ind_y_2: case EOR_ind_y_2:
-        case LDA_ind_y_2: case LDX_ind_y_2: case LDY_ind_y_2: case LSR_ind_y_2:
-        case ORA_ind_y_2: case SBC_ind_y_2: case STA_ind_y_2: case DCP_ind_y_2:
-        case ISC_ind_y_2: case LAX_ind_y_2: case RLA_ind_y_2: case RRA_ind_y_2:
-        case SHA_ind_y_2: case SLO_ind_y_2: case SRE_ind_y_2:
+        MICRO(ADC_ind_y_2) MICRO(AND_ind_y_2) MICRO(CMP_ind_y_2) MICRO(EOR_ind_y_2)
+        MICRO(LDA_ind_y_2) MICRO(LDX_ind_y_2) MICRO(LDY_ind_y_2) MICRO(LSR_ind_y_2)
+        MICRO(ORA_ind_y_2) MICRO(SBC_ind_y_2) MICRO(STA_ind_y_2) MICRO(DCP_ind_y_2)
+        MICRO(ISC_ind_y_2) MICRO(LAX_ind_y_2) MICRO(RLA_ind_y_2) MICRO(RRA_ind_y_2)
+        MICRO(SHA_ind_y_2) MICRO(SLO_ind_y_2) MICRO(SRE_ind_y_2)
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_y_3: case AND_ind_y_3: case CMP_ind_y_3: case EOR_ind_y_3:
-        case LDA_ind_y_3: case LDX_ind_y_3: case LDY_ind_y_3: case LSR_ind_y_3:
-        case ORA_ind_y_3: case SBC_ind_y_3: case STA_ind_y_3: case DCP_ind_y_3:
-        case ISC_ind_y_3: case LAX_ind_y_3: case RLA_ind_y_3: case RRA_ind_y_3:
-        case SHA_ind_y_3: case SLO_ind_y_3: case SRE_ind_y_3:
+        MICRO(ADC_ind_y_3) MICRO(AND_ind_y_3) MICRO(CMP_ind_y_3) MICRO(EOR_ind_y_3)
+        MICRO(LDA_ind_y_3) MICRO(LDX_ind_y_3) MICRO(LDY_ind_y_3) MICRO(LSR_ind_y_3)
+        MICRO(ORA_ind_y_3) MICRO(SBC_ind_y_3) MICRO(STA_ind_y_3) MICRO(DCP_ind_y_3)
+        MICRO(ISC_ind_y_3) MICRO(LAX_ind_y_3) MICRO(RLA_ind_y_3) MICRO(RRA_ind_y_3)
+        MICRO(SHA_ind_y_3) MICRO(SLO_ind_y_3) MICRO(SRE_ind_y_3)
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
         
-        case LSR_ind_y_4: case STA_ind_y_4: case DCP_ind_y_4: case ISC_ind_y_4:
-        case RLA_ind_y_4: case RRA_ind_y_4: case SLO_ind_y_4: case SRE_ind_y_4:
+        MICRO(LSR_ind_y_4) MICRO(STA_ind_y_4) MICRO(DCP_ind_y_4) MICRO(ISC_ind_y_4)
+        MICRO(RLA_ind_y_4) MICRO(RRA_ind_y_4) MICRO(SLO_ind_y_4) MICRO(SRE_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case LSR_ind_y_5: case DCP_ind_y_5: case ISC_ind_y_5: case RLA_ind_y_5:
-        case RRA_ind_y_5: case SLO_ind_y_5: case SRE_ind_y_5:
+        MICRO(LSR_ind_y_5) MICRO(DCP_ind_y_5) MICRO(ISC_ind_y_5) MICRO(RLA_ind_y_5)
+        MICRO(RRA_ind_y_5) MICRO(SLO_ind_y_5) MICRO(SRE_ind_y_5)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -911,8 +967,8 @@ CPU::executeOneCycle()
         // Adressing mode: Relative (shared behavior)
         //
             
-        case BCC_rel_2: case BCS_rel_2: case BEQ_rel_2: case BMI_rel_2:
-        case BNE_rel_2: case BPL_rel_2: case BVC_rel_2: case BVS_rel_2:
+        MICRO(BCC_rel_2) MICRO(BCS_rel_2) MICRO(BEQ_rel_2) MICRO(BMI_rel_2)
+        MICRO(BNE_rel_2) MICRO(BPL_rel_2) MICRO(BVC_rel_2) MICRO(BVS_rel_2)
         {
             IDLE_READ_IMPLIED
             u8 pc_hi = HI_BYTE(regPC);
@@ -925,13 +981,13 @@ CPU::executeOneCycle()
             DONE
         }
             
-        case branch_3_underflow:
+        MICRO(branch_3_underflow)
             
             IDLE_READ_FROM(regPC + 0x100)
             POLL_INT_AGAIN
             DONE
             
-        case branch_3_overflow:
+        MICRO(branch_3_overflow)
             
             IDLE_READ_FROM(regPC - 0x100)
             POLL_INT_AGAIN
@@ -945,24 +1001,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - /
 
-        case ADC_imm:
+        MICRO(ADC_imm)
 
             READ_IMMEDIATE
             adc(regD);
             POLL_INT
             DONE
 
-        case ADC_zpg_2:
-        case ADC_zpg_x_3:
+        MICRO(ADC_zpg_2)
+        MICRO(ADC_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             adc(regD);
             POLL_INT
             DONE
 
-        case ADC_abs_x_3:
-        case ADC_abs_y_3:
-        case ADC_ind_y_4:
+        MICRO(ADC_abs_x_3)
+        MICRO(ADC_abs_y_3)
+        MICRO(ADC_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -974,11 +1030,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ADC_abs_3:
-        case ADC_abs_x_4:
-        case ADC_abs_y_4:
-        case ADC_ind_x_5:
-        case ADC_ind_y_5:
+        MICRO(ADC_abs_3)
+        MICRO(ADC_abs_x_4)
+        MICRO(ADC_abs_y_4)
+        MICRO(ADC_ind_x_5)
+        MICRO(ADC_ind_y_5)
             
             READ_FROM_ADDRESS
             adc(regD);
@@ -993,24 +1049,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case AND_imm:
+        MICRO(AND_imm)
             
             READ_IMMEDIATE
             loadA(regA & regD);
             POLL_INT
             DONE
 
-        case AND_zpg_2:
-        case AND_zpg_x_3:
+        MICRO(AND_zpg_2)
+        MICRO(AND_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(regA & regD);
             POLL_INT
             DONE
             
-        case AND_abs_x_3:
-        case AND_abs_y_3:
-        case AND_ind_y_4:
+        MICRO(AND_abs_x_3)
+        MICRO(AND_abs_y_3)
+        MICRO(AND_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1022,11 +1078,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case AND_abs_3:
-        case AND_abs_x_4:
-        case AND_abs_y_4:
-        case AND_ind_x_5:
-        case AND_ind_y_5:
+        MICRO(AND_abs_3)
+        MICRO(AND_abs_x_4)
+        MICRO(AND_abs_y_4)
+        MICRO(AND_ind_x_5)
+        MICRO(AND_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(regA & regD);
@@ -1044,38 +1100,38 @@ CPU::executeOneCycle()
         #define DO_ASL_ACC setC(regA & 0x80); loadA(regA << 1);
         #define DO_ASL setC(regD & 0x80); regD = regD << 1;
 
-        case ASL_acc:
+        MICRO(ASL_acc)
             
             IDLE_READ_IMPLIED
             DO_ASL_ACC
             POLL_INT
             DONE
             
-        case ASL_zpg_3:
-        case ASL_zpg_x_4:
+        MICRO(ASL_zpg_3)
+        MICRO(ASL_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ASL
             CONTINUE
            
-        case ASL_abs_4:
-        case ASL_abs_x_5:
-        case ASL_ind_x_6:
+        MICRO(ASL_abs_4)
+        MICRO(ASL_abs_x_5)
+        MICRO(ASL_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ASL
             CONTINUE
             
-        case ASL_zpg_4:
-        case ASL_zpg_x_5:
+        MICRO(ASL_zpg_4)
+        MICRO(ASL_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ASL_abs_5:
-        case ASL_abs_x_6:
-        case ASL_ind_x_7:
+        MICRO(ASL_abs_5)
+        MICRO(ASL_abs_x_6)
+        MICRO(ASL_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1089,7 +1145,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
     
-        case BCC_rel:
+        MICRO(BCC_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1108,7 +1164,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case BCS_rel:
+        MICRO(BCS_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1127,7 +1183,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case BEQ_rel:
+        MICRO(BEQ_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1146,21 +1202,21 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - /
             
-        case BIT_zpg_2:
+        MICRO(BIT_zpg_2)
             
             READ_FROM_ZERO_PAGE
-            setN(regD & 128);
+            valN = regD;
+            valZ = regD & regA;
             setV(regD & 64);
-            setZ((regD & regA) == 0);
             POLL_INT
             DONE
 
-        case BIT_abs_3:
+        MICRO(BIT_abs_3)
             
             READ_FROM_ADDRESS
-            setN(regD & 128);
+            valN = regD;
+            valZ = regD & regA;
             setV(regD & 64);
-            setZ((regD & regA) == 0);
             POLL_INT
             DONE
 
@@ -1172,7 +1228,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case BMI_rel:
+        MICRO(BMI_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1191,7 +1247,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case BNE_rel:
+        MICRO(BNE_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1210,7 +1266,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case BPL_rel:
+        MICRO(BPL_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1229,13 +1285,13 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V    B
         //              - - - 1 - -    1
             
-        case BRK_2:
+        MICRO(BRK_2)
             
             setB(1);
             PUSH_PCH
             CONTINUE
             
-        case BRK_3:
+        MICRO(BRK_3)
         
             PUSH_PCL
             
@@ -1252,19 +1308,19 @@ CPU::executeOneCycle()
                 CONTINUE
             }
             
-        case BRK_4:
+        MICRO(BRK_4)
             
             PUSH_P
             CONTINUE
             
-        case BRK_5:
+        MICRO(BRK_5)
             
             READ_FROM(0xFFFE);
             setPCL(regD);
             setI(1);
             CONTINUE
             
-        case BRK_6:
+        MICRO(BRK_6)
             
             READ_FROM(0xFFFF);
             setPCH(regD);
@@ -1274,19 +1330,19 @@ CPU::executeOneCycle()
                            // after a BRK command, but not NMIs.
             DONE
             
-        case BRK_nmi_4:
+        MICRO(BRK_nmi_4)
             
             PUSH_P
             CONTINUE
             
-        case BRK_nmi_5:
+        MICRO(BRK_nmi_5)
             
             READ_FROM(0xFFFA);
             setPCL(regD);
             setI(1);
             CONTINUE
             
-        case BRK_nmi_6:
+        MICRO(BRK_nmi_6)
             
             READ_FROM(0xFFFB);
             setPCH(regD);
@@ -1301,7 +1357,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case BVC_rel:
+        MICRO(BVC_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1320,7 +1376,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case BVS_rel:
+        MICRO(BVS_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1339,7 +1395,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - 0 - - -
 
-        case CLC:
+        MICRO(CLC)
             
             IDLE_READ_IMPLIED
             setC(0);
@@ -1354,7 +1410,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - 0 -
 
-        case CLD:
+        MICRO(CLD)
             
             IDLE_READ_IMPLIED
             setD(0);
@@ -1369,7 +1425,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - 0 - -
 
-        case CLI:
+        MICRO(CLI)
             
             POLL_INT
             setI(0);
@@ -1384,7 +1440,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - 0
 
-        case CLV:
+        MICRO(CLV)
             
             IDLE_READ_IMPLIED
             setV(0);
@@ -1399,24 +1455,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case CMP_imm:
+        MICRO(CMP_imm)
             
             READ_IMMEDIATE
             cmp(regA, regD);
             POLL_INT
             DONE
 
-        case CMP_zpg_2:
-        case CMP_zpg_x_3:
+        MICRO(CMP_zpg_2)
+        MICRO(CMP_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             cmp(regA, regD);
             POLL_INT
             DONE
 
-        case CMP_abs_x_3:
-        case CMP_abs_y_3:
-        case CMP_ind_y_4:
+        MICRO(CMP_abs_x_3)
+        MICRO(CMP_abs_y_3)
+        MICRO(CMP_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1428,11 +1484,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case CMP_abs_3:
-        case CMP_abs_x_4:
-        case CMP_abs_y_4:
-        case CMP_ind_x_5:
-        case CMP_ind_y_5:
+        MICRO(CMP_abs_3)
+        MICRO(CMP_abs_x_4)
+        MICRO(CMP_abs_y_4)
+        MICRO(CMP_ind_x_5)
+        MICRO(CMP_ind_y_5)
             
             READ_FROM_ADDRESS
             cmp(regA, regD);
@@ -1447,21 +1503,21 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case CPX_imm:
+        MICRO(CPX_imm)
             
             READ_IMMEDIATE
             cmp(regX, regD);
             POLL_INT
             DONE
             
-        case CPX_zpg_2:
+        MICRO(CPX_zpg_2)
             
             READ_FROM_ZERO_PAGE
             cmp(regX, regD);
             POLL_INT
             DONE
             
-        case CPX_abs_3:
+        MICRO(CPX_abs_3)
             
             READ_FROM_ADDRESS
             cmp(regX, regD);
@@ -1476,21 +1532,21 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case CPY_imm:
+        MICRO(CPY_imm)
             
             READ_IMMEDIATE
             cmp(regY, regD);
             POLL_INT
             DONE
 
-        case CPY_zpg_2:
+        MICRO(CPY_zpg_2)
             
             READ_FROM_ZERO_PAGE
             cmp(regY, regD);
             POLL_INT
             DONE
 
-        case CPY_abs_3:
+        MICRO(CPY_abs_3)
             
             READ_FROM_ADDRESS
             cmp(regY, regD);
@@ -1507,31 +1563,31 @@ CPU::executeOneCycle()
             
         #define DO_DEC regD--;
             
-        case DEC_zpg_3:
-        case DEC_zpg_x_4:
+        MICRO(DEC_zpg_3)
+        MICRO(DEC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DEC_zpg_4:
-        case DEC_zpg_x_5:
+        MICRO(DEC_zpg_4)
+        MICRO(DEC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case DEC_abs_4:
-        case DEC_abs_x_5:
-        case DEC_ind_x_6:
+        MICRO(DEC_abs_4)
+        MICRO(DEC_abs_x_5)
+        MICRO(DEC_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DEC_abs_5:
-        case DEC_abs_x_6:
-        case DEC_ind_x_7:
+        MICRO(DEC_abs_5)
+        MICRO(DEC_abs_x_6)
+        MICRO(DEC_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1545,7 +1601,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case DEX:
+        MICRO(DEX)
             
             IDLE_READ_IMPLIED
             loadX(regX - 1);
@@ -1560,7 +1616,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case DEY:
+        MICRO(DEY)
             
             IDLE_READ_IMPLIED
             loadY(regY - 1);
@@ -1577,24 +1633,24 @@ CPU::executeOneCycle()
 
         #define DO_EOR loadA(regA ^ regD);
             
-        case EOR_imm:
+        MICRO(EOR_imm)
             
             READ_IMMEDIATE
             DO_EOR
             POLL_INT
             DONE
             
-        case EOR_zpg_2:
-        case EOR_zpg_x_3:
+        MICRO(EOR_zpg_2)
+        MICRO(EOR_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             DO_EOR
             POLL_INT
             DONE
             
-        case EOR_abs_x_3:
-        case EOR_abs_y_3:
-        case EOR_ind_y_4:
+        MICRO(EOR_abs_x_3)
+        MICRO(EOR_abs_y_3)
+        MICRO(EOR_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1606,11 +1662,11 @@ CPU::executeOneCycle()
                 DONE
             }
 
-        case EOR_abs_3:
-        case EOR_abs_x_4:
-        case EOR_abs_y_4:
-        case EOR_ind_x_5:
-        case EOR_ind_y_5:
+        MICRO(EOR_abs_3)
+        MICRO(EOR_abs_x_4)
+        MICRO(EOR_abs_y_4)
+        MICRO(EOR_ind_x_5)
+        MICRO(EOR_ind_y_5)
             
             READ_FROM_ADDRESS
             DO_EOR
@@ -1627,31 +1683,31 @@ CPU::executeOneCycle()
             
         #define DO_INC regD++;
             
-        case INC_zpg_3:
-        case INC_zpg_x_4:
+        MICRO(INC_zpg_3)
+        MICRO(INC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case INC_zpg_4:
-        case INC_zpg_x_5:
+        MICRO(INC_zpg_4)
+        MICRO(INC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
           
-        case INC_abs_4:
-        case INC_abs_x_5:
-        case INC_ind_x_6:
+        MICRO(INC_abs_4)
+        MICRO(INC_abs_x_5)
+        MICRO(INC_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case INC_abs_5:
-        case INC_abs_x_6:
-        case INC_ind_x_7:
+        MICRO(INC_abs_5)
+        MICRO(INC_abs_x_6)
+        MICRO(INC_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1665,7 +1721,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case INX:
+        MICRO(INX)
             
             IDLE_READ_IMPLIED
             loadX(regX + 1);
@@ -1680,7 +1736,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case INY:
+        MICRO(INY)
             
             IDLE_READ_IMPLIED
             loadY(regY + 1);
@@ -1695,36 +1751,36 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
           
-        case JMP_abs:
+        MICRO(JMP_abs)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_2:
+        MICRO(JMP_abs_2)
             
             FETCH_ADDR_HI
             regPC = LO_HI(regADL, regADH);
             POLL_INT
             DONE
 
-        case JMP_abs_ind:
+        MICRO(JMP_abs_ind)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_ind_2:
+        MICRO(JMP_abs_ind_2)
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case JMP_abs_ind_3:
+        MICRO(JMP_abs_ind_3)
             
             READ_FROM_ADDRESS
             setPCL(regD);
             regADL++;
             CONTINUE
             
-        case JMP_abs_ind_4:
+        MICRO(JMP_abs_ind_4)
             
             READ_FROM_ADDRESS
             setPCH(regD);
@@ -1739,27 +1795,27 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case JSR:
+        MICRO(JSR)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JSR_2:
+        MICRO(JSR_2)
             
             IDLE_PULL
             CONTINUE
             
-        case JSR_3:
+        MICRO(JSR_3)
             
             PUSH_PCH
             CONTINUE
             
-        case JSR_4:
+        MICRO(JSR_4)
             
             PUSH_PCL
             CONTINUE
             
-        case JSR_5:
+        MICRO(JSR_5)
             
             FETCH_ADDR_HI
             regPC = LO_HI(regADL, regADH);
@@ -1774,24 +1830,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case LDA_imm:
+        MICRO(LDA_imm)
             
             READ_IMMEDIATE
             loadA(regD);
             POLL_INT
             DONE
 
-        case LDA_zpg_2:
-        case LDA_zpg_x_3:
+        MICRO(LDA_zpg_2)
+        MICRO(LDA_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(regD);
             POLL_INT
             DONE
           
-        case LDA_abs_x_3:
-        case LDA_abs_y_3:
-        case LDA_ind_y_4:
+        MICRO(LDA_abs_x_3)
+        MICRO(LDA_abs_y_3)
+        MICRO(LDA_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1803,11 +1859,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDA_abs_3:
-        case LDA_abs_x_4:
-        case LDA_abs_y_4:
-        case LDA_ind_x_5:
-        case LDA_ind_y_5:
+        MICRO(LDA_abs_3)
+        MICRO(LDA_abs_x_4)
+        MICRO(LDA_abs_y_4)
+        MICRO(LDA_ind_x_5)
+        MICRO(LDA_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(regD);
@@ -1822,23 +1878,23 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case LDX_imm:
+        MICRO(LDX_imm)
             
             READ_IMMEDIATE
             loadX(regD);
             POLL_INT
             DONE
 
-        case LDX_zpg_2:
-        case LDX_zpg_y_3:
+        MICRO(LDX_zpg_2)
+        MICRO(LDX_zpg_y_3)
             
             READ_FROM_ZERO_PAGE
             loadX(regD);
             POLL_INT
             DONE
 
-        case LDX_abs_y_3:
-        case LDX_ind_y_4:
+        MICRO(LDX_abs_y_3)
+        MICRO(LDX_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1850,10 +1906,10 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDX_abs_3:
-        case LDX_abs_y_4:
-        case LDX_ind_x_5:
-        case LDX_ind_y_5:
+        MICRO(LDX_abs_3)
+        MICRO(LDX_abs_y_4)
+        MICRO(LDX_ind_x_5)
+        MICRO(LDX_ind_y_5)
             
             READ_FROM_ADDRESS
             loadX(regD);
@@ -1868,23 +1924,23 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
  
-        case LDY_imm:
+        MICRO(LDY_imm)
             
             READ_IMMEDIATE
             loadY(regD);
             POLL_INT
             DONE
             
-        case LDY_zpg_2:
-        case LDY_zpg_x_3:
+        MICRO(LDY_zpg_2)
+        MICRO(LDY_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadY(regD);
             POLL_INT
             DONE
 
-        case LDY_abs_x_3:
-        case LDY_ind_y_4:
+        MICRO(LDY_abs_x_3)
+        MICRO(LDY_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1896,10 +1952,10 @@ CPU::executeOneCycle()
                 DONE
             }
 
-        case LDY_abs_3:
-        case LDY_abs_x_4:
-        case LDY_ind_x_5:
-        case LDY_ind_y_5:
+        MICRO(LDY_abs_3)
+        MICRO(LDY_abs_x_4)
+        MICRO(LDY_ind_x_5)
+        MICRO(LDY_ind_y_5)
             
             READ_FROM_ADDRESS
             loadY(regD);
@@ -1914,42 +1970,42 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              0 / / - - -
 
-        case LSR_acc:
+        MICRO(LSR_acc)
             
             IDLE_READ_IMPLIED
             setC(regA & 1); loadA(regA >> 1);
             POLL_INT
             DONE
 
-        case LSR_zpg_3:
-        case LSR_zpg_x_4:
+        MICRO(LSR_zpg_3)
+        MICRO(LSR_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             setC(regD & 1); regD = regD >> 1;
             CONTINUE
             
-        case LSR_zpg_4:
-        case LSR_zpg_x_5:
+        MICRO(LSR_zpg_4)
+        MICRO(LSR_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case LSR_abs_4:
-        case LSR_abs_x_5:
-        case LSR_abs_y_5:
-        case LSR_ind_x_6:
-        case LSR_ind_y_6:
+        MICRO(LSR_abs_4)
+        MICRO(LSR_abs_x_5)
+        MICRO(LSR_abs_y_5)
+        MICRO(LSR_ind_x_6)
+        MICRO(LSR_ind_y_6)
             
             WRITE_TO_ADDRESS
             setC(regD & 1); regD = regD >> 1;
             CONTINUE
             
-        case LSR_abs_5:
-        case LSR_abs_x_6:
-        case LSR_abs_y_6:
-        case LSR_ind_x_7:
-        case LSR_ind_y_7:
+        MICRO(LSR_abs_5)
+        MICRO(LSR_abs_x_6)
+        MICRO(LSR_abs_y_6)
+        MICRO(LSR_ind_x_7)
+        MICRO(LSR_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1963,26 +2019,26 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case NOP:
+        MICRO(NOP)
             
             IDLE_READ_IMPLIED
             POLL_INT
             DONE
 
-        case NOP_imm:
+        MICRO(NOP_imm)
             
             IDLE_READ_IMMEDIATE
             POLL_INT
             DONE
 
-        case NOP_zpg_2:
-        case NOP_zpg_x_3:
+        MICRO(NOP_zpg_2)
+        MICRO(NOP_zpg_x_3)
             
             IDLE_READ_FROM_ZERO_PAGE
             POLL_INT
             DONE
             
-        case NOP_abs_x_3:
+        MICRO(NOP_abs_x_3)
             
             IDLE_READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1993,8 +2049,8 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case NOP_abs_3:
-        case NOP_abs_x_4:
+        MICRO(NOP_abs_3)
+        MICRO(NOP_abs_x_4)
             
             IDLE_READ_FROM_ADDRESS
             POLL_INT
@@ -2008,24 +2064,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case ORA_imm:
+        MICRO(ORA_imm)
             
             READ_IMMEDIATE
             loadA(regA | regD);
             POLL_INT
             DONE
             
-        case ORA_zpg_2:
-        case ORA_zpg_x_3:
+        MICRO(ORA_zpg_2)
+        MICRO(ORA_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(regA | regD);
             POLL_INT
             DONE
 
-        case ORA_abs_x_3:
-        case ORA_abs_y_3:
-        case ORA_ind_y_4:
+        MICRO(ORA_abs_x_3)
+        MICRO(ORA_abs_y_3)
+        MICRO(ORA_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2037,11 +2093,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ORA_abs_3:
-        case ORA_abs_x_4:
-        case ORA_abs_y_4:
-        case ORA_ind_x_5:
-        case ORA_ind_y_5:
+        MICRO(ORA_abs_3)
+        MICRO(ORA_abs_x_4)
+        MICRO(ORA_abs_y_4)
+        MICRO(ORA_ind_x_5)
+        MICRO(ORA_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(regA | regD);
@@ -2056,7 +2112,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case PHA_2:
+        MICRO(PHA_2)
             
             PUSH_A
             POLL_INT
@@ -2070,7 +2126,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case PHP_2:
+        MICRO(PHP_2)
             
             PUSH_P
             POLL_INT
@@ -2084,12 +2140,12 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case PLA_2:
+        MICRO(PLA_2)
             
             regSP++;
             CONTINUE
             
-        case PLA_3:
+        MICRO(PLA_3)
             
             PULL_A
             POLL_INT
@@ -2103,13 +2159,13 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / / / /
             
-        case PLP_2:
+        MICRO(PLP_2)
 
             IDLE_PULL
             regSP++;
             CONTINUE
             
-        case PLP_3:
+        MICRO(PLP_3)
 
             POLL_INT // Interrupts are polled before P is pulled
             PULL_P
@@ -2128,38 +2184,38 @@ CPU::executeOneCycle()
         #define DO_ROL_ACC { int c = !!getC(); setC(regA & 0x80); loadA((regA << 1) | c); }
         #define DO_ROL { int c = !!getC(); setC(regD & 0x80); regD = (regD << 1) | c; }
 
-        case ROL_acc:
+        MICRO(ROL_acc)
             
             IDLE_READ_IMPLIED
             DO_ROL_ACC
             POLL_INT
             DONE
             
-        case ROL_zpg_3:
-        case ROL_zpg_x_4:
+        MICRO(ROL_zpg_3)
+        MICRO(ROL_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case ROL_zpg_4:
-        case ROL_zpg_x_5:
+        MICRO(ROL_zpg_4)
+        MICRO(ROL_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ROL_abs_4:
-        case ROL_abs_x_5:
-        case ROL_ind_x_6:
+        MICRO(ROL_abs_4)
+        MICRO(ROL_abs_x_5)
+        MICRO(ROL_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case ROL_abs_5:
-        case ROL_abs_x_6:
-        case ROL_ind_x_7:
+        MICRO(ROL_abs_5)
+        MICRO(ROL_abs_x_6)
+        MICRO(ROL_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2178,38 +2234,38 @@ CPU::executeOneCycle()
         #define DO_ROR_ACC { int c = !!getC(); setC(regA & 0x1); loadA((regA >> 1) | (c << 7)); }
         #define DO_ROR { int c = !!getC(); setC(regD & 0x1); regD = (regD >> 1) | (c << 7); }
             
-        case ROR_acc:
+        MICRO(ROR_acc)
             
             IDLE_READ_IMPLIED
             DO_ROR_ACC
             POLL_INT
             DONE
             
-        case ROR_zpg_3:
-        case ROR_zpg_x_4:
+        MICRO(ROR_zpg_3)
+        MICRO(ROR_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case ROR_zpg_4:
-        case ROR_zpg_x_5:
+        MICRO(ROR_zpg_4)
+        MICRO(ROR_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ROR_abs_4:
-        case ROR_abs_x_5:
-        case ROR_ind_x_6:
+        MICRO(ROR_abs_4)
+        MICRO(ROR_abs_x_5)
+        MICRO(ROR_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case ROR_abs_5:
-        case ROR_abs_x_6:
-        case ROR_ind_x_7:
+        MICRO(ROR_abs_5)
+        MICRO(ROR_abs_x_6)
+        MICRO(ROR_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2223,25 +2279,25 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / / / /
             
-        case RTI_2:
+        MICRO(RTI_2)
             
             IDLE_PULL
             regSP++;
             CONTINUE
             
-        case RTI_3:
+        MICRO(RTI_3)
             
             PULL_P
             regSP++;
             CONTINUE
             
-        case RTI_4:
+        MICRO(RTI_4)
             
             PULL_PCL
             regSP++;
             CONTINUE
             
-        case RTI_5:
+        MICRO(RTI_5)
             
             PULL_PCH
             POLL_INT
@@ -2255,24 +2311,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case RTS_2:
+        MICRO(RTS_2)
             
             IDLE_PULL
             regSP++;
             CONTINUE
             
-        case RTS_3:
+        MICRO(RTS_3)
             
             PULL_PCL
             regSP++;
             CONTINUE
             
-        case RTS_4:
+        MICRO(RTS_4)
             
             PULL_PCH
             CONTINUE
             
-        case RTS_5:
+        MICRO(RTS_5)
             
             IDLE_READ_IMMEDIATE
             POLL_INT
@@ -2286,24 +2342,24 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - /
   
-        case SBC_imm:
+        MICRO(SBC_imm)
             
             READ_IMMEDIATE
             sbc(regD);
             POLL_INT
             DONE
             
-        case SBC_zpg_2:
-        case SBC_zpg_x_3:
+        MICRO(SBC_zpg_2)
+        MICRO(SBC_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             sbc(regD);
             POLL_INT
             DONE
             
-        case SBC_abs_x_3:
-        case SBC_abs_y_3:
-        case SBC_ind_y_4:
+        MICRO(SBC_abs_x_3)
+        MICRO(SBC_abs_y_3)
+        MICRO(SBC_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2315,11 +2371,11 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case SBC_abs_3:
-        case SBC_abs_x_4:
-        case SBC_abs_y_4:
-        case SBC_ind_x_5:
-        case SBC_ind_y_5:
+        MICRO(SBC_abs_3)
+        MICRO(SBC_abs_x_4)
+        MICRO(SBC_abs_y_4)
+        MICRO(SBC_ind_x_5)
+        MICRO(SBC_ind_y_5)
             
             READ_FROM_ADDRESS
             sbc(regD);
@@ -2334,7 +2390,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - 1 - - -
 
-        case SEC:
+        MICRO(SEC)
             
             IDLE_READ_IMPLIED
             setC(1);
@@ -2349,7 +2405,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - 1 -
 
-        case SED:
+        MICRO(SED)
             
             IDLE_READ_IMPLIED
             setD(1);
@@ -2364,12 +2420,12 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - 1 - -
 
-        case SEI:
+        MICRO(SEI)
             
             POLL_IRQ
             setI(1);
             
-        case SEI_cont: // fallthrough
+        MICRO(SEI_cont) // fallthrough
             
             next = SEI_cont;
             IDLE_READ_IMPLIED
@@ -2384,25 +2440,25 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case STA_zpg_2:
-        case STA_zpg_x_3:
+        MICRO(STA_zpg_2)
+        MICRO(STA_zpg_x_3)
             
             regD = regA;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STA_abs_3:
-        case STA_abs_x_4:
+        MICRO(STA_abs_3)
+        MICRO(STA_abs_x_4)
             
             regD = regA;
             WRITE_TO_ADDRESS
             POLL_INT
             DONE
             
-        case STA_abs_y_4:
-        case STA_ind_x_5:
-        case STA_ind_y_5:
+        MICRO(STA_abs_y_4)
+        MICRO(STA_ind_x_5)
+        MICRO(STA_ind_y_5)
             
             regD = regA;
             WRITE_TO_ADDRESS
@@ -2417,15 +2473,15 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case STX_zpg_2:
-        case STX_zpg_y_3:
+        MICRO(STX_zpg_2)
+        MICRO(STX_zpg_y_3)
             
             regD = regX;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STX_abs_3:
+        MICRO(STX_abs_3)
             
             regD = regX;
             WRITE_TO_ADDRESS
@@ -2440,15 +2496,15 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case STY_zpg_2:
-        case STY_zpg_x_3:
+        MICRO(STY_zpg_2)
+        MICRO(STY_zpg_x_3)
             
             regD = regY;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STY_abs_3:
+        MICRO(STY_abs_3)
             
             regD = regY;
             WRITE_TO_ADDRESS
@@ -2463,7 +2519,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case TAX:
+        MICRO(TAX)
             
             IDLE_READ_IMPLIED
             loadX(regA);
@@ -2478,7 +2534,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case TAY:
+        MICRO(TAY)
             
             IDLE_READ_IMPLIED
             loadY(regA);
@@ -2493,7 +2549,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case TSX:
+        MICRO(TSX)
             
             IDLE_READ_IMPLIED
             loadX(regSP);
@@ -2508,7 +2564,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case TXA:
+        MICRO(TXA)
             
             IDLE_READ_IMPLIED
             loadA(regX);
@@ -2523,7 +2579,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
 
-        case TXS:
+        MICRO(TXS)
             
             IDLE_READ_IMPLIED
             regSP = regX;
@@ -2538,7 +2594,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case TYA:
+        MICRO(TYA)
             
             IDLE_READ_IMPLIED
             loadA(regY);
@@ -2558,7 +2614,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case ALR_imm:
+        MICRO(ALR_imm)
             
             READ_IMMEDIATE
             regA = regA & regD;
@@ -2575,7 +2631,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case ANC_imm:
+        MICRO(ANC_imm)
             
             READ_IMMEDIATE
             loadA(regA & regD);
@@ -2591,7 +2647,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - /
 
-        case ARR_imm:
+        MICRO(ARR_imm)
         {
             READ_IMMEDIATE
             
@@ -2600,8 +2656,7 @@ CPU::executeOneCycle()
             // Taken from Frodo...
             regA = (getC() ? (tmp2 >> 1) | 0x80 : tmp2 >> 1);
             if (!getD()) {
-                setN(regA & 0x80);
-                setZ(regA == 0);
+                setNZ(regA);
                 setC(regA & 0x40);
                 setV((regA & 0x40) ^ ((regA & 0x20) << 1));
             } else {
@@ -2632,7 +2687,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
 
-        case AXS_imm:
+        MICRO(AXS_imm)
         {
             READ_IMMEDIATE
             
@@ -2653,36 +2708,36 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
             
-        case DCP_zpg_3:
-        case DCP_zpg_x_4:
+        MICRO(DCP_zpg_3)
+        MICRO(DCP_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             regD--;
             CONTINUE
             
-        case DCP_zpg_4:
-        case DCP_zpg_x_5:
+        MICRO(DCP_zpg_4)
+        MICRO(DCP_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             cmp(regA, regD);
             POLL_INT
             DONE
             
-        case DCP_abs_4:
-        case DCP_abs_x_5:
-        case DCP_abs_y_5:
-        case DCP_ind_x_6:
-        case DCP_ind_y_6:
+        MICRO(DCP_abs_4)
+        MICRO(DCP_abs_x_5)
+        MICRO(DCP_abs_y_5)
+        MICRO(DCP_ind_x_6)
+        MICRO(DCP_ind_y_6)
             
             WRITE_TO_ADDRESS
             regD--;
             CONTINUE
             
-        case DCP_abs_5:
-        case DCP_abs_x_6:
-        case DCP_abs_y_6:
-        case DCP_ind_x_7:
-        case DCP_ind_y_7:
+        MICRO(DCP_abs_5)
+        MICRO(DCP_abs_x_6)
+        MICRO(DCP_abs_y_6)
+        MICRO(DCP_ind_x_7)
+        MICRO(DCP_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(regA, regD);
@@ -2697,36 +2752,36 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - /
             
-        case ISC_zpg_3:
-        case ISC_zpg_x_4:
+        MICRO(ISC_zpg_3)
+        MICRO(ISC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             regD++;
             CONTINUE
             
-        case ISC_zpg_4:
-        case ISC_zpg_x_5:
+        MICRO(ISC_zpg_4)
+        MICRO(ISC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             sbc(regD);
             POLL_INT
             DONE
 
-        case ISC_abs_4:
-        case ISC_abs_x_5:
-        case ISC_abs_y_5:
-        case ISC_ind_x_6:
-        case ISC_ind_y_6:
+        MICRO(ISC_abs_4)
+        MICRO(ISC_abs_x_5)
+        MICRO(ISC_abs_y_5)
+        MICRO(ISC_ind_x_6)
+        MICRO(ISC_ind_y_6)
             
             WRITE_TO_ADDRESS
             regD++;
             CONTINUE
             
-        case ISC_abs_5:
-        case ISC_abs_x_6:
-        case ISC_abs_y_6:
-        case ISC_ind_x_7:
-        case ISC_ind_y_7:
+        MICRO(ISC_abs_5)
+        MICRO(ISC_abs_x_6)
+        MICRO(ISC_abs_y_6)
+        MICRO(ISC_ind_x_7)
+        MICRO(ISC_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(regD);
@@ -2741,7 +2796,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
             
-        case LAS_abs_y_3:
+        MICRO(LAS_abs_y_3)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2756,7 +2811,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LAS_abs_y_4:
+        MICRO(LAS_abs_y_4)
             
             READ_FROM_ADDRESS
             regD &= regSP;
@@ -2774,8 +2829,8 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
             
-        case LAX_zpg_2:
-        case LAX_zpg_y_3:
+        MICRO(LAX_zpg_2)
+        MICRO(LAX_zpg_y_3)
             
             READ_FROM_ZERO_PAGE
             loadA(regD);
@@ -2783,8 +2838,8 @@ CPU::executeOneCycle()
             POLL_INT
             DONE
             
-        case LAX_abs_y_3:
-        case LAX_ind_y_4:
+        MICRO(LAX_abs_y_3)
+        MICRO(LAX_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2797,10 +2852,10 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LAX_abs_3:
-        case LAX_abs_y_4:
-        case LAX_ind_x_5:
-        case LAX_ind_y_5:
+        MICRO(LAX_abs_3)
+        MICRO(LAX_abs_y_4)
+        MICRO(LAX_ind_x_5)
+        MICRO(LAX_ind_y_5)
             
             READ_FROM_ADDRESS;
             loadA(regD);
@@ -2816,36 +2871,36 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - -
             
-        case RLA_zpg_3:
-        case RLA_zpg_x_4:
+        MICRO(RLA_zpg_3)
+        MICRO(RLA_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case RLA_zpg_4:
-        case RLA_zpg_x_5:
+        MICRO(RLA_zpg_4)
+        MICRO(RLA_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(regA & regD);
             POLL_INT
             DONE
             
-        case RLA_abs_4:
-        case RLA_abs_x_5:
-        case RLA_abs_y_5:
-        case RLA_ind_x_6:
-        case RLA_ind_y_6:
+        MICRO(RLA_abs_4)
+        MICRO(RLA_abs_x_5)
+        MICRO(RLA_abs_y_5)
+        MICRO(RLA_ind_x_6)
+        MICRO(RLA_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_abs_5:
-        case RLA_abs_x_6:
-        case RLA_abs_y_6:
-        case RLA_ind_x_7:
-        case RLA_ind_y_7:
+        MICRO(RLA_abs_5)
+        MICRO(RLA_abs_x_6)
+        MICRO(RLA_abs_y_6)
+        MICRO(RLA_ind_x_7)
+        MICRO(RLA_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(regA & regD);
@@ -2859,36 +2914,36 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / / - - /
             
-        case RRA_zpg_3:
-        case RRA_zpg_x_4:
+        MICRO(RRA_zpg_3)
+        MICRO(RRA_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case RRA_zpg_4:
-        case RRA_zpg_x_5:
+        MICRO(RRA_zpg_4)
+        MICRO(RRA_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             adc(regD);
             POLL_INT
             DONE
 
-        case RRA_abs_4:
-        case RRA_abs_x_5:
-        case RRA_abs_y_5:
-        case RRA_ind_x_6:
-        case RRA_ind_y_6:
+        MICRO(RRA_abs_4)
+        MICRO(RRA_abs_x_5)
+        MICRO(RRA_abs_y_5)
+        MICRO(RRA_ind_x_6)
+        MICRO(RRA_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_abs_5:
-        case RRA_abs_x_6:
-        case RRA_abs_y_6:
-        case RRA_ind_x_7:
-        case RRA_ind_y_7:
+        MICRO(RRA_abs_5)
+        MICRO(RRA_abs_x_6)
+        MICRO(RRA_abs_y_6)
+        MICRO(RRA_ind_x_7)
+        MICRO(RRA_ind_y_7)
             
             WRITE_TO_ADDRESS
             adc(regD);
@@ -2903,16 +2958,16 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case SAX_zpg_2:
-        case SAX_zpg_y_3:
+        MICRO(SAX_zpg_2)
+        MICRO(SAX_zpg_y_3)
             
             regD = regA & regX;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
 
-        case SAX_abs_3:
-        case SAX_ind_x_5:
+        MICRO(SAX_abs_3)
+        MICRO(SAX_ind_x_5)
             
             regD = regA & regX;
             WRITE_TO_ADDRESS
@@ -2927,7 +2982,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case SHA_abs_y_3:
+        MICRO(SHA_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2950,13 +3005,13 @@ CPU::executeOneCycle()
             
             CONTINUE
             
-        case SHA_abs_y_4:
+        MICRO(SHA_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
             DONE
             
-        case SHA_ind_y_4:
+        MICRO(SHA_ind_y_4)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2979,7 +3034,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case SHA_ind_y_5:
+        MICRO(SHA_ind_y_5)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -2993,7 +3048,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
        
-        case SHX_abs_y_3:
+        MICRO(SHX_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -3016,7 +3071,7 @@ CPU::executeOneCycle()
             
             CONTINUE
            
-        case SHX_abs_y_4:
+        MICRO(SHX_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -3030,7 +3085,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case SHY_abs_x_3:
+        MICRO(SHY_abs_x_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -3053,7 +3108,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case SHY_abs_x_4:
+        MICRO(SHY_abs_x_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -3069,36 +3124,36 @@ CPU::executeOneCycle()
 
         #define DO_SLO setC(regD & 128); regD <<= 1;
 
-        case SLO_zpg_3:
-        case SLO_zpg_x_4:
+        MICRO(SLO_zpg_3)
+        MICRO(SLO_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_SLO
             CONTINUE
             
-        case SLO_zpg_4:
-        case SLO_zpg_x_5:
+        MICRO(SLO_zpg_4)
+        MICRO(SLO_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(regA | regD);
             POLL_INT
             DONE
             
-        case SLO_abs_4:
-        case SLO_abs_x_5:
-        case SLO_abs_y_5:
-        case SLO_ind_x_6:
-        case SLO_ind_y_6:
+        MICRO(SLO_abs_4)
+        MICRO(SLO_abs_x_5)
+        MICRO(SLO_abs_y_5)
+        MICRO(SLO_ind_x_6)
+        MICRO(SLO_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_abs_5:
-        case SLO_abs_x_6:
-        case SLO_abs_y_6:
-        case SLO_ind_x_7:
-        case SLO_ind_y_7:
+        MICRO(SLO_abs_5)
+        MICRO(SLO_abs_x_6)
+        MICRO(SLO_abs_y_6)
+        MICRO(SLO_ind_x_7)
+        MICRO(SLO_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(regA | regD);
@@ -3115,36 +3170,36 @@ CPU::executeOneCycle()
 
         #define DO_SRE setC(regD & 1); regD >>= 1;
 
-        case SRE_zpg_3:
-        case SRE_zpg_x_4:
+        MICRO(SRE_zpg_3)
+        MICRO(SRE_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_SRE
             CONTINUE
             
-        case SRE_zpg_4:
-        case SRE_zpg_x_5:
+        MICRO(SRE_zpg_4)
+        MICRO(SRE_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(regA ^ regD);
             POLL_INT
             DONE
             
-        case SRE_abs_4:
-        case SRE_abs_x_5:
-        case SRE_abs_y_5:
-        case SRE_ind_x_6:
-        case SRE_ind_y_6:
+        MICRO(SRE_abs_4)
+        MICRO(SRE_abs_x_5)
+        MICRO(SRE_abs_y_5)
+        MICRO(SRE_ind_x_6)
+        MICRO(SRE_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_abs_5:
-        case SRE_abs_x_6:
-        case SRE_abs_y_6:
-        case SRE_ind_x_7:
-        case SRE_ind_y_7:
+        MICRO(SRE_abs_5)
+        MICRO(SRE_abs_x_6)
+        MICRO(SRE_abs_y_6)
+        MICRO(SRE_ind_x_7)
+        MICRO(SRE_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(regA ^ regD);
@@ -3159,7 +3214,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              - - - - - -
             
-        case TAS_abs_y_3:
+        MICRO(TAS_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -3184,7 +3239,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case TAS_abs_y_4:
+        MICRO(TAS_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -3197,7 +3252,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case ANE_imm:
+        MICRO(ANE_imm)
             
             READ_IMMEDIATE
             loadA(regX & regD & (regA | 0xEE));
@@ -3212,7 +3267,7 @@ CPU::executeOneCycle()
         // Flags:       N Z C I D V
         //              / / - - - -
 
-        case LXA_imm:
+        MICRO(LXA_imm)
             
             READ_IMMEDIATE
             regX = regD & (regA | 0xEE);
@@ -3227,3 +3282,7 @@ CPU::executeOneCycle()
     }
 }
 
+template bool CPU::executeOneCycle<C64Memory>();
+template bool CPU::executeOneCycle<VC1541Memory>();
+template bool CPU::executeOneCycle<Watched<C64Memory>>();
+template bool CPU::executeOneCycle<Watched<VC1541Memory>>();
@@ -37,10 +37,10 @@ typedef enum {
 } AddressingMode;
 
 /*! @brief    Breakpoint type
- *  @details  Each memory call is marked with a breakpoint tag. Originally,
- *            each cell is tagged with NO_BREAKPOINT which has no effect. CPU
- *            execution will stop if the memory cell is tagged with one of the
- *            following breakpoint types:
+ *  @details  Each breakpoint carries one or more breakpoint tags. Addresses
+ *            without a breakpoint are tagged with NO_BREAKPOINT which has no
+ *            effect. CPU execution will stop if the address is tagged with
+ *            one of the following breakpoint types:
  *            HARD_BREAKPOINT : Execution is halted.
  *            SOFT_BREAKPOINT : Execution is halted and the tag is deleted.
  */
@@ -54,6 +54,8 @@ typedef enum {
 /*! @brief    Error state of the virtual CPU
  *  @details  CPU_OK indicates normal operation. When a (soft or hard)
  *            breakpoint is reached, state CPU_BREAKPOINT_REACHED is entered.
+ *            CPU_WATCHPOINT_REACHED is set when a watched memory cell has
+ *            been accessed.
  *            CPU_ILLEGAL_INSTRUCTION is set when an opcode is not understood
  *            by the CPU. Once the CPU enters a different state than CPU_OK,
  *            the execution thread is terminated.
@@ -62,7 +64,8 @@ typedef enum {
     CPU_OK = 0,
     CPU_SOFT_BREAKPOINT_REACHED,
     CPU_HARD_BREAKPOINT_REACHED,
-    CPU_ILLEGAL_INSTRUCTION
+    CPU_ILLEGAL_INSTRUCTION,
+    CPU_WATCHPOINT_REACHED
 } ErrorState;
 
 /*! @brief    CPU info
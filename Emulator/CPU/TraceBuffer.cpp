@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "TraceBuffer.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+static const char traceMagic[4] = { 'V', 'C', 'T', 'R' };
+
+bool
+TraceBuffer::map(const char *path, size_t capacity)
+{
+    size_t entries = 1;
+    while (entries < capacity) entries <<= 1;
+    size_t bytes = sizeof(TraceHeader) + entries * sizeof(TraceRecord);
+    void *storage;
+
+    if (path) {
+
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, bytes) != 0) { close(fd); return false; }
+        storage = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+    } else {
+
+        storage = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (storage == MAP_FAILED) return false;
+
+    // The old ring is kept if mapping fails
+    unmap();
+    header = (TraceHeader *)storage;
+    records = (TraceRecord *)(header + 1);
+    mappedBytes = bytes;
+
+    memcpy(header->magic, traceMagic, sizeof(traceMagic));
+    header->recordSize = sizeof(TraceRecord);
+    header->capacity = entries;
+    clear();
+    return true;
+}
+
+bool
+TraceBuffer::load(const char *path)
+{
+    TraceHeader h;
+    struct stat st;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    // Check the header before mapping the file
+    if (fstat(fd, &st) != 0 ||
+        read(fd, &h, sizeof(h)) != sizeof(h) ||
+        memcmp(h.magic, traceMagic, sizeof(traceMagic)) != 0 ||
+        h.recordSize != sizeof(TraceRecord) ||
+        h.capacity == 0 || (h.capacity & (h.capacity - 1)) != 0 ||
+        (u64)st.st_size != sizeof(TraceHeader) + h.capacity * sizeof(TraceRecord)) {
+
+        close(fd);
+        return false;
+    }
+
+    void *storage = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (storage == MAP_FAILED) return false;
+
+    unmap();
+    header = (TraceHeader *)storage;
+    records = (TraceRecord *)(header + 1);
+    mappedBytes = st.st_size;
+    cursor = UINT64_MAX;
+    return true;
+}
+
+void
+TraceBuffer::unmap()
+{
+    if (header) munmap(header, mappedBytes);
+
+    header = NULL;
+    records = NULL;
+    mappedBytes = 0;
+    cursor = UINT64_MAX;
+}
+
+RecordedInstruction
+TraceBuffer::get(u64 nr)
+{
+    assert(nr >= first() && nr < appended());
+
+    u64 mask = header->capacity - 1;
+    u64 pos = header->count - 1;
+    u64 cycle = header->cycle;
+
+    // Start from the cursor if it is closer than the latest record
+    if (cursor >= first() && cursor < header->count) {
+        u64 distance = cursor > nr ? cursor - nr : nr - cursor;
+        if (distance < pos - nr) { pos = cursor; cycle = cursorCycle; }
+    }
+    for (; pos > nr; pos--) cycle -= records[pos & mask].delta;
+    for (; pos < nr; pos++) cycle += records[(pos + 1) & mask].delta;
+
+    cursor = nr;
+    cursorCycle = cycle;
+
+    TraceRecord *r = &records[nr & mask];
+    RecordedInstruction result;
+
+    result.cycle = cycle;
+    result.pc = r->pc;
+    result.byte1 = r->bytes[0];
+    result.byte2 = r->bytes[1];
+    result.byte3 = r->bytes[2];
+    result.a = r->a;
+    result.x = r->x;
+    result.y = r->y;
+    result.sp = r->sp;
+    result.flags = r->flags;
+
+    return result;
+}
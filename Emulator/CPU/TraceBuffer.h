@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _TRACEBUFFER_INC
+#define _TRACEBUFFER_INC
+
+#include "basic.h"
+#include "CPUTypes.h"
+
+//! @brief    Trace file header
+typedef struct {
+
+    //! @brief    Magic bytes ('V','C','T','R')
+    char magic[4];
+
+    //! @brief    Size of a single record in bytes
+    u32 recordSize;
+
+    //! @brief    Number of records the ring can hold (a power of two)
+    u64 capacity;
+
+    //! @brief    Number of records ever appended
+    u64 count;
+
+    //! @brief    Cycle of the latest record
+    u64 cycle;
+
+} TraceHeader;
+
+/*! @brief    A single traced instruction
+ *  @details  The cycle is stored relative to the previous record. Absolute
+ *            values are reconstructed from the cycle stored in the header.
+ *            All three bytes following the program counter are recorded,
+ *            regardless of the instruction length.
+ */
+typedef struct {
+
+    u32 delta;
+    u16 pc;
+    u8 bytes[3];
+    u8 a;
+    u8 x;
+    u8 y;
+    u8 sp;
+    u8 flags;
+    u8 unused;
+
+} TraceRecord;
+
+
+/*! @brief    A ring of traced instructions in memory mapped storage
+ *  @details  Records have a fixed size and are written without any further
+ *            processing, so that tracing can stay enabled at full speed. The
+ *            ring either lives in anonymous memory or in a file. A file
+ *            mapping is kept up to date by the operating system and survives
+ *            a crash of the emulator. It can be decoded offline by loading it
+ *            into a trace buffer of its own.
+ */
+class TraceBuffer {
+
+    //! @brief    Start of the mapped storage (header followed by the records)
+    TraceHeader *header = NULL;
+
+    //! @brief    First record
+    TraceRecord *records = NULL;
+
+    //! @brief    Size of the mapped storage in bytes
+    size_t mappedBytes = 0;
+
+    //! @brief    Index of the last record whose cycle has been reconstructed
+    u64 cursor = UINT64_MAX;
+
+    //! @brief    Reconstructed cycle of the cursor record
+    u64 cursorCycle = 0;
+
+public:
+
+    //! @brief    Destructor
+    ~TraceBuffer() { unmap(); }
+
+    /*! @brief    Sets up a ring in anonymous memory
+     *  @details  The capacity is rounded up to the next power of two.
+     */
+    bool allocate(size_t capacity) { return map(NULL, capacity); }
+
+    /*! @brief    Sets up a ring in a file
+     *  @details  An existing file is overwritten. The capacity is rounded up
+     *            to the next power of two.
+     */
+    bool create(const char *path, size_t capacity) { return map(path, capacity); }
+
+    /*! @brief    Maps an existing trace file for reading
+     *  @details  The buffer must not be written to afterwards.
+     */
+    bool load(const char *path);
+
+    //! @brief    Returns true if storage is mapped
+    bool isMapped() { return header != NULL; }
+
+    //! @brief    Returns the number of records the ring can hold
+    u64 capacity() { return header->capacity; }
+
+    //! @brief    Returns the number of records ever appended
+    u64 appended() { return header->count; }
+
+    //! @brief    Returns the index of the oldest record still in the ring
+    u64 first() { return header->count > header->capacity ? header->count - header->capacity : 0; }
+
+    //! @brief    Deletes all records
+    void clear() { header->count = 0; header->cycle = 0; cursor = UINT64_MAX; }
+
+    /*! @brief    Appends a record
+     *  @details  The oldest record is overwritten if the ring is full. Cycle
+     *            gaps that do not fit into a record are clamped. Older records
+     *            then report a cycle that is too large.
+     */
+    void append(u64 cycle, u16 pc, u8 byte1, u8 byte2, u8 byte3,
+                u8 a, u8 x, u8 y, u8 sp, u8 flags) {
+
+        u64 delta = cycle - header->cycle;
+        TraceRecord *r = &records[header->count & (header->capacity - 1)];
+
+        r->delta = delta <= UINT32_MAX ? (u32)delta : UINT32_MAX;
+        r->pc = pc;
+        r->bytes[0] = byte1;
+        r->bytes[1] = byte2;
+        r->bytes[2] = byte3;
+        r->a = a;
+        r->x = x;
+        r->y = y;
+        r->sp = sp;
+        r->flags = flags;
+
+        header->cycle = cycle;
+        header->count++;
+    }
+
+    /*! @brief    Decodes a record
+     *  @details  nr is the index of the record in the sequence of all
+     *            appended records and must lie between first() and
+     *            appended() - 1. Decoding neighbouring records one after
+     *            another takes constant time per record.
+     */
+    RecordedInstruction get(u64 nr);
+
+private:
+
+    //! @brief    Maps storage for a ring of the specified capacity
+    bool map(const char *path, size_t capacity);
+
+    //! @brief    Releases the mapped storage
+    void unmap();
+};
+
+#endif
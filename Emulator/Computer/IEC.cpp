@@ -20,7 +20,6 @@ IEC::IEC(C64 &ref) : C64Component(ref)
         { &atnLine,             sizeof(atnLine),                CLEAR_ON_RESET },
         { &clockLine,           sizeof(clockLine),              CLEAR_ON_RESET },
         { &dataLine,            sizeof(dataLine),               CLEAR_ON_RESET },
-        { &isDirtyC64Side,      sizeof(isDirtyC64Side),         CLEAR_ON_RESET },
         { &isDirtyDriveSide,    sizeof(isDirtyDriveSide),       CLEAR_ON_RESET },
 
         { &device1Atn,          sizeof(device1Atn),             CLEAR_ON_RESET },
@@ -187,7 +186,12 @@ IEC::updateIecLinesC64Side()
     ciaData = !!(ciaBits & 0x20);
     
     updateIecLines();
-    isDirtyC64Side = false;
+}
+
+void
+IEC::setNeedsUpdateC64Side()
+{
+    c64->scheduleEvent(EVENT_IEC, 0);
 }
 
 void
@@ -25,12 +25,6 @@ public:
 	//! @brief    Current value of the IEC bus data line
 	bool dataLine;
 	 	
-    /*! @brief    Indicates if the bus lines variables need an undate,
-     *            because the values coming from the C64 side have changed.
-     *  @deprecated
-     */
-    bool isDirtyC64Side;
-
     /*! @brief    Indicates if the bus lines variables need an undate,
      *            because the values coming from the drive side have changed.
      *  @deprecated
@@ -80,9 +74,11 @@ public:
     //! @brief    Returns true if the IEC currently transfers data.
     bool isBusy() { return busActivity > 0; }
     
-    //! @brief    Requensts an update of the bus lines from the C64 side.
-    //! @deprecated
-    void setNeedsUpdateC64Side() { isDirtyC64Side = true; }
+    /*! @brief    Requensts an update of the bus lines from the C64 side.
+     *  @details  The update is carried out by the C64's cycle scheduler in
+     *            the first clock phase of the next cycle.
+     */
+    void setNeedsUpdateC64Side();
 
     //! @brief    Requensts an update of the bus lines from the drive side.
     //! @deprecated
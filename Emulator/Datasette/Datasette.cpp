@@ -29,6 +29,7 @@ Datasette::Datasette(C64 &ref) : C64Component(ref)
         { &nextFallingEdge,    sizeof(nextFallingEdge),   CLEAR_ON_RESET },
         { &playKey,            sizeof(playKey),           CLEAR_ON_RESET },
         { &motor,              sizeof(motor),             CLEAR_ON_RESET },
+        { &syncCycle,          sizeof(syncCycle),         CLEAR_ON_RESET },
         
         { NULL,                0,                         0 }};
     
@@ -89,6 +90,7 @@ Datasette::setHeadInCycles(u64 value)
     while (headInCycles <= value && head < size)
         advanceHead(true);
     printf("Head is %llu (max %llu)\n", head, size);
+    scheduleNextEvent();
 }
 
 bool
@@ -193,21 +195,29 @@ Datasette::pressPlay()
     if (!hasTape())
         return;
     
+    suspend();
     debug(TAP_DEBUG, "pressPlay\n");
+    advance(c64->cpu.cycle + 1);
     playKey = true;
 
     // Schedule first pulse
     u64 length = pulseLength();
     nextRisingEdge = length / 2;
     nextFallingEdge = length;
+    scheduleNextEvent();
+    resume();
 }
 
 void
 Datasette::pressStop()
 {
+    suspend();
     debug(TAP_DEBUG, "pressStop\n");
+    advance(c64->cpu.cycle + 1);
     setMotor(false);
     playKey = false;
+    scheduleNextEvent();
+    resume();
 }
 
 void
@@ -216,31 +226,65 @@ Datasette::setMotor(bool value)
     if (motor == value)
         return;
     
+    // The CPU has switched the motor in the current cycle
+    advance(c64->cpu.cycle);
     motor = value;
+    scheduleNextEvent();
 }
 
 void
-Datasette::_execute()
+Datasette::advance(u64 cycle)
 {
-    if (!hasTape() || !playKey || !motor)
+    if (cycle <= syncCycle)
         return;
     
-    nextRisingEdge--;
-    nextFallingEdge--;
-    
-    if (nextRisingEdge == 0) {
-        _executeRising();
+    if (playKey && motor) {
+        i64 elapsed = (i64)(cycle - syncCycle);
+        nextRisingEdge -= elapsed;
+        nextFallingEdge -= elapsed;
+    }
+    syncCycle = cycle;
+}
+
+void
+Datasette::scheduleNextEvent()
+{
+    if (!hasTape() || !playKey || !motor) {
+        c64->cancelEvent(EVENT_TAPE);
         return;
     }
+    
+    // An edge is due in the cycle in which its counter reaches zero
+    u64 next = (head >= size) ? syncCycle : NEVER;
+    if (nextRisingEdge > 0)
+        next = MIN(next, syncCycle + nextRisingEdge - 1);
+    if (nextFallingEdge > 0 && head < size)
+        next = MIN(next, syncCycle + nextFallingEdge - 1);
+    
+    c64->scheduleEvent(EVENT_TAPE, next);
+}
 
-    if (nextFallingEdge == 0 && head < size) {
-        _executeFalling();
+void
+Datasette::execute()
+{
+    if (!hasTape() || !playKey || !motor) {
+        c64->cancelEvent(EVENT_TAPE);
         return;
     }
     
-    if (head >= size) {
-        pressStop();
+    advance(c64->cpu.cycle + 1);
+    
+    if (nextRisingEdge == 0) {
+        _executeRising();
+    } else if (nextFallingEdge == 0 && head < size) {
+        _executeFalling();
+    } else if (head >= size) {
+        debug(TAP_DEBUG, "End of tape\n");
+        motor = false;
+        playKey = false;
     }
+    
+    scheduleNextEvent();
 }
 
 void
@@ -62,13 +62,22 @@ class Datasette : public C64Component {
     u32 headInSeconds = 0;
     
     /*! @brief    Next scheduled rising edge on data line
+     *  @details  Number of cycles, counted from syncCycle on
      */
     i64 nextRisingEdge = 0;
     
     /*! @brief    Next scheduled falling edge on data line
+     *  @details  Number of cycles, counted from syncCycle on
      */
     i64 nextFallingEdge = 0;
     
+    /*! @brief    First cycle not yet taken into account by the edge counters
+     *  @details  The edge counters are only updated when the datasette is
+     *            serviced by the C64's cycle scheduler or when its state
+     *            changes.
+     */
+    u64 syncCycle = 0;
+    
     /*! @brief    Indicates whether the play key is pressed
      */
     bool playKey = false;
@@ -180,14 +189,22 @@ public:
      */
     void setMotor(bool value);
 
-    /*! @brief  Executes the virtual datasette
+    /*! @brief    Executes the virtual datasette
+     *  @details  This function is invoked by the C64's cycle scheduler
+     *            whenever an edge on the data line is due.
      */
-    void execute() { if (playKey && motor) _execute(); }
+    void execute();
 
 private:
 
-    //! @brief    Internal execution function
-    void _execute();
+    /*! @brief    Updates the edge counters.
+     *  @details  Takes all cycles up to (but not including) the specified
+     *            cycle into account.
+     */
+    void advance(u64 cycle);
+    
+    //! @brief    Informs the C64's cycle scheduler about the next due edge.
+    void scheduleNextEvent();
 
     //! @brief    Simulates the falling edge of a pulse
     void _executeFalling();
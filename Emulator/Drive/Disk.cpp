@@ -75,7 +75,7 @@ Disk::Disk(C64 &ref) : C64Component(ref)
     SnapshotItem items[] = {        
         { &writeProtected,  sizeof(writeProtected), KEEP_ON_RESET },
         { &modified,        sizeof(modified),       KEEP_ON_RESET },
-        { &data,            sizeof(data),           KEEP_ON_RESET },
+        { halftrackRef,     sizeof(halftrackRef),   KEEP_ON_RESET | QWORD_ARRAY },
         { &length,          sizeof(length),         KEEP_ON_RESET | WORD_ARRAY },
         { NULL,             0,                      0 }};
     
@@ -96,6 +96,7 @@ Disk::Disk(C64 &ref) : C64Component(ref)
         if (i & 0x01) bitExpansion[i] |= 0x0100000000000000;
     }
     
+    memset(halftrackRef, 0, sizeof(halftrackRef));
     clearDisk();
 }
 
@@ -122,11 +123,47 @@ Disk::ping()
     HardwareComponent::ping();
 }
 
+void
+Disk::willSaveToBuffer(u8 **buffer)
+{
+    // Replace the halftrack data by fingerprints
+    for (Halftrack ht = 1; ht <= maxNumberOfHalftracks; ht++) {
+        
+        if (!halftrackBlob[ht]) {
+            halftrackBlob[ht] = BlobStore::intern(data.halftrack[ht], maxBytesOnTrack);
+        }
+        halftrackRef[ht] = halftrackBlob[ht]->fingerprint;
+    }
+}
+
+void
+Disk::didLoadFromBuffer(u8 **buffer)
+{
+    // Fetch all halftracks that differ from the current ones
+    for (Halftrack ht = 1; ht <= maxNumberOfHalftracks; ht++) {
+        
+        if (halftrackBlob[ht] && halftrackBlob[ht]->fingerprint == halftrackRef[ht])
+            continue;
+
+        c64->restoreBlob(halftrackRef[ht], halftrackBlob[ht],
+                         data.halftrack[ht], maxBytesOnTrack);
+    }
+    changed = true;
+}
+
+void
+Disk::collectBlobs(BlobList &blobs)
+{
+    for (Halftrack ht = 1; ht <= maxNumberOfHalftracks; ht++)
+        if (halftrackBlob[ht]) blobs.push_back(halftrackBlob[ht]);
+}
+
 void
 Disk::setModified(bool b)
 {
     if (b != modified) {
         modified = b;
+        changed = true;
         c64->drive1.ping();
         c64->drive2.ping();
     }
@@ -219,6 +256,8 @@ Disk::clearHalftrack(Halftrack ht)
 {
     memset(&data.halftrack[ht], 0x55, sizeof(data.halftrack[ht]));
     length.halftrack[ht] = sizeof(data.halftrack[ht]) * 8;
+    halftrackBlob[ht].reset();
+    changed = true;
 }
 
 void
@@ -115,6 +115,12 @@ private:
      */
     bool modified;
     
+    /*! @brief   Indicates whether the disk has changed since the last
+     *           incremental snapshot
+     *  @seealso HardwareComponent::updateBuffer()
+     */
+    bool changed = true;
+    
     
     //
     // Disk data
@@ -147,6 +153,20 @@ public:
         };
         u16 track[43][2];
     } length;
+    
+    /*! @brief    Fingerprints of all halftracks
+     *  @details  Snapshots only contain these fingerprints. The halftrack
+     *            data is kept in the blob store.
+     */
+    u64 halftrackRef[85];
+    
+private:
+    
+    /*! @brief    Blobs holding the halftrack data
+     *  @details  If an entry is set, the corresponding halftrack matches the
+     *            blob. Writing to a halftrack clears its entry.
+     */
+    BlobRef halftrackBlob[85];
 
     
     //
@@ -190,6 +210,11 @@ public:
     
     void dump();
     void ping();
+    void willSaveToBuffer(u8 **buffer);
+    void didLoadFromBuffer(u8 **buffer);
+    void collectBlobs(BlobList &blobs);
+    bool stateChanged() { return changed; }
+    void stateUpdated() { changed = false; }
 
     
     
@@ -197,10 +222,10 @@ public:
     bool isWriteProtected() { return writeProtected; }
 
     //! @brief Sets write protection flag
-    void setWriteProtection(bool b) { writeProtected = b; }
+    void setWriteProtection(bool b) { writeProtected = b; changed = true; }
 
     //! @brief Toggles the write protection flag
-    void toggleWriteProtection() { writeProtected = !writeProtected; }
+    void toggleWriteProtection() { writeProtected = !writeProtected; changed = true; }
 
     //! @brief Returns modified flag
     bool isModified() { return modified; }
@@ -298,6 +323,8 @@ public:
      */
     void _writeBitToHalftrack(Halftrack ht, HeadPosition pos, bool bit) {
         assert(isValidHeadPositon(ht, pos));
+        changed = true;
+        if (halftrackBlob[ht]) halftrackBlob[ht].reset();
         if (bit) {
             data.halftrack[ht][pos / 8] |= (0x0080 >> (pos % 8));
         } else {
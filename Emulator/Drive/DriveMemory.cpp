@@ -16,14 +16,15 @@ VC1541Memory::VC1541Memory(VC1541 *drive, C64 &ref) : Memory(ref)
     this->drive = drive;
     
     memset(rom, 0, sizeof(rom));
+    romRef = 0;
     stack = &ram[0x0100];
     
     // Register snapshot items
     SnapshotItem items[] = {
 
-    { ram,  sizeof(ram), KEEP_ON_RESET },
-    { rom,  sizeof(rom), KEEP_ON_RESET },
-    { NULL, 0,           0 }};
+    { ram,     sizeof(ram),    KEEP_ON_RESET },
+    { &romRef, sizeof(romRef), KEEP_ON_RESET },
+    { NULL,    0,              0 }};
 
     registerSnapshotItems(items, sizeof(items));
 }
@@ -52,62 +53,65 @@ VC1541Memory::dump()
 	msg("\n");
 }
 
-u8 
-VC1541Memory::peek(u16 addr)
+void
+VC1541Memory::willSaveToBuffer(u8 **buffer)
 {
-    if (addr >= 0x8000) {
-        
-        // 0xC000 - 0xFFFF : ROM
-        // 0x8000 - 0xBFFF : ROM (repeated)
-        //return mem[addr | 0xC000];
-        return rom[addr & 0x3FFF];
-        
+    // Replace the ROM image by its fingerprint
+    if (romIsLoaded()) {
+        romRef = BlobStore::refresh(romBlob, rom, sizeof(rom));
     } else {
-        
-        // Map to range 0x0000 - 0x1FFF
-        addr &= 0x1FFF;
-        
-        // 0x0000 - 0x07FF : RAM
-        // 0x0800 - 0x17FF : unmapped
-        // 0x1800 - 0x1BFF : VIA 1 (repeats every 16 bytes)
-        // 0x1C00 - 0x1FFF : VIA 2 (repeats every 16 bytes)
-        return
-        (addr < 0x0800) ? ram[addr] :
-        (addr < 0x1800) ? addr >> 8 :
-        (addr < 0x1C00) ? drive->via1.peek(addr & 0xF) :
-        drive->via2.peek(addr & 0xF);
+        romRef = 0;
+        romBlob.reset();
     }
 }
 
-u8
-VC1541Memory::spypeek(u16 addr)
+void
+VC1541Memory::didLoadFromBuffer(u8 **buffer)
 {
-    if (addr >= 0x8000) {
-        return rom[addr & 0x3FFF];
-    } else {
-        addr &= 0x1FFF;
-        return
-        (addr < 0x0800) ? ram[addr] :
-        (addr < 0x1800) ? addr >> 8 :
-        (addr < 0x1C00) ? drive->via1.spypeek(addr & 0xF) :
-        drive->via2.spypeek(addr & 0xF);
+    // Fetch the referenced ROM image (fails the load if it is missing)
+    if (romRef == 0) {
+        memset(rom, 0, sizeof(rom));
+        romBlob.reset();
+        return;
     }
+    c64->restoreBlob(romRef, romBlob, rom, sizeof(rom));
 }
 
-void 
-VC1541Memory::poke(u16 addr, u8 value)
+void
+VC1541Memory::collectBlobs(BlobList &blobs)
 {
-    if (addr >= 0x8000) { // ROM
-        return;
-    }
+    if (romBlob) blobs.push_back(romBlob);
+}
+
+u8 
+VC1541Memory::peekIO(u16 addr)
+{
+    assert(addr >= 0x0800 && addr <= 0x1FFF);
     
-    // Map to range 0x0000 - 0x1FFF
-    addr &= 0x1FFF;
+    // 0x0800 - 0x17FF : unmapped
+    // 0x1800 - 0x1BFF : VIA 1 (repeats every 16 bytes)
+    // 0x1C00 - 0x1FFF : VIA 2 (repeats every 16 bytes)
+    return
+    (addr < 0x1800) ? addr >> 8 :
+    (addr < 0x1C00) ? drive->via1.peek(addr & 0xF) :
+    drive->via2.peek(addr & 0xF);
+}
+
+u8
+VC1541Memory::spypeekIO(u16 addr)
+{
+    assert(addr >= 0x0800 && addr <= 0x1FFF);
     
-    if (addr < 0x0800) { // RAM
-        ram[addr] = value;
-        return;
-    }
+    return
+    (addr < 0x1800) ? addr >> 8 :
+    (addr < 0x1C00) ? drive->via1.spypeek(addr & 0xF) :
+    drive->via2.spypeek(addr & 0xF);
+}
+
+void 
+VC1541Memory::pokeIO(u16 addr, u8 value)
+{
+    assert(addr >= 0x0800 && addr <= 0x1FFF);
     
     if (addr >= 0x1C00) { // VIA 2
         drive->via2.poke(addr & 0xF, value);
@@ -16,7 +16,7 @@ class VC1541;
 
 /*! @brief    Represents RAM and ROM of a virtual VC1541 floopy disk drive.
  */
-class VC1541Memory : public Memory {
+class VC1541Memory final : public Memory {
     
     private:
     
@@ -31,6 +31,16 @@ class VC1541Memory : public Memory {
     //! @brief    Read Only Memory
     u8 rom[0x4000];
     
+    /*! @brief    Fingerprint of the ROM image
+     *  @details  Snapshots only contain the fingerprint. The ROM image is
+     *            kept in the blob store. A value of 0 indicates that no ROM is
+     *            installed.
+     */
+    u64 romRef;
+    
+    //! @brief    Blob holding the ROM image referenced in the last snapshot
+    BlobRef romBlob;
+    
     
     //
     //! @functiongroup Creating and destructing
@@ -49,6 +59,9 @@ class VC1541Memory : public Memory {
 
 	void reset();
 	void dump();
+    void willSaveToBuffer(u8 **buffer);
+    void didLoadFromBuffer(u8 **buffer);
+    void collectBlobs(BlobList &blobs);
 
     
     //
@@ -72,15 +85,34 @@ class VC1541Memory : public Memory {
     //! @functiongroup Accessing RAM
     //
 
-    // Reading from memory
-    u8 peek(u16 addr);
+    /* Reading from memory
+     *
+     * RAM and ROM accesses are handled inline. Accesses to the VIA range are
+     * delegated to peekIO() and pokeIO().
+     */
+    u8 peek(u16 addr) {
+        if (addr >= 0x8000) return rom[addr & 0x3FFF];
+        if ((addr & 0x1FFF) < 0x0800) return ram[addr & 0x07FF];
+        return peekIO(addr & 0x1FFF); }
     u8 peekZP(u8 addr) { return ram[addr]; }
+    u8 peekIO(u16 addr);
+    
+    //! @brief    Returns true if addr is mapped to one of the VIAs
+    static bool isIO(u16 addr) { return addr < 0x8000 && (addr & 0x1FFF) >= 0x0800; }
 
-    // Reading from memory without side effects
-    u8 spypeek(u16 addr);
+    // Reading from memory without side effects (RAM and ROM inline)
+    u8 spypeek(u16 addr) {
+        if (addr >= 0x8000) return rom[addr & 0x3FFF];
+        if ((addr & 0x1FFF) < 0x0800) return ram[addr & 0x07FF];
+        return spypeekIO(addr & 0x1FFF); }
+    u8 spypeekIO(u16 addr);
     
     // Writing into memory
-    void poke(u16 addr, u8 value);
+    void poke(u16 addr, u8 value) {
+        if (addr >= 0x8000) return;
+        if ((addr & 0x1FFF) < 0x0800) ram[addr & 0x07FF] = value;
+        else pokeIO(addr & 0x1FFF, value); }
+    void pokeIO(u16 addr, u8 value);
     void pokeZP(u8 addr, u8 value) { ram[addr] = value; }
 };
 
@@ -55,6 +55,7 @@ VC1541::VC1541(unsigned nr, C64 &ref) : C64Component(ref)
     
     insertionStatus = NOT_INSERTED;
     sendSoundMessages = true;
+    fastPath = false;
     resetDisk();
 }
 
@@ -128,13 +129,22 @@ VC1541::execute(u64 duration)
     elapsedTime += duration;
     while (nextClock < elapsedTime || nextCarry < elapsedTime) {
 
-        if (nextClock <= nextCarry) {
+        if (nextClock <= nextCarry && fastPath && isQuiet()) {
+            
+            // Execute the next instruction in one go (isQuiet() rules out watchpoints)
+            do {
+                cpu.cycle++;
+                result = cpu.executeOneCycle<VC1541Memory>();
+                nextClock += 10000;
+            } while (!cpu.inFetchPhase() && result);
+            
+        } else if (nextClock <= nextCarry) {
             
             // Execute CPU and VIAs
             u64 cycle = ++cpu.cycle;
-            result = cpu.executeOneCycle();
-            if (cycle >= via1.wakeUpCycle) via1.execute(); else via1.idleCounter++;
-            if (cycle >= via2.wakeUpCycle) via2.execute(); else via2.idleCounter++;
+            result = cpu.executeCycle<VC1541Memory>();
+            if (cycle >= via1.wakeUpCycle) via1.execute();
+            if (cycle >= via2.wakeUpCycle) via2.execute();
             updateByteReady();
             if (c64->iec.isDirtyDriveSide) c64->iec.updateIecLinesDriveSide();
 
@@ -152,6 +162,88 @@ VC1541::execute(u64 duration)
     return result;
 }
 
+bool
+VC1541::isQuiet()
+{
+    // The longest instruction (or interrupt sequence) takes 7 cycles
+    u64 horizon = cpu.cycle + 8;
+    
+    return
+    cpu.inFetchPhase() &&
+    !spinning &&
+    via1.wakeUpCycle > horizon &&
+    via2.wakeUpCycle > horizon &&
+    !c64->iec.isDirtyDriveSide &&
+    mem.guards == NULL && // Looking ahead would trigger watchpoints
+    !nextInstructionAccessesIO();
+}
+
+bool
+VC1541::nextInstructionAccessesIO()
+{
+    u16 pc = cpu.regPC;
+    
+    // Opcode and operand fetches (including dummy reads)
+    if (mem.isIO(pc) || mem.isIO(pc + 1) || mem.isIO(pc + 2)) return true;
+    
+    u8 opcode = mem.peek(pc);
+    u8 lo = mem.peek(pc + 1);
+    u16 addr = HI_LO(mem.peek(pc + 2), lo);
+    u16 target;
+    
+    // Some illegal instructions write to unstable addresses. They are always
+    // executed cycle by cycle.
+    
+    switch (cpu.getAddressingMode(opcode)) {
+            
+        case ADDR_ABSOLUTE:
+            
+            return mem.isIO(addr);
+            
+        case ADDR_ABSOLUTE_X:
+            
+            if (opcode == 0x9C) return true; // SHY
+            target = addr + cpu.regX;
+            break;
+            
+        case ADDR_ABSOLUTE_Y:
+            
+            if (opcode == 0x9B || opcode == 0x9E || opcode == 0x9F) return true; // TAS, SHX, SHA
+            target = addr + cpu.regY;
+            break;
+            
+        case ADDR_INDIRECT_X:
+            
+            lo += cpu.regX;
+            return mem.isIO(HI_LO(mem.ram[(u8)(lo + 1)], mem.ram[lo]));
+            
+        case ADDR_INDIRECT_Y:
+            
+            if (opcode == 0x93) return true; // SHA
+            addr = HI_LO(mem.ram[(u8)(lo + 1)], mem.ram[lo]);
+            target = addr + cpu.regY;
+            break;
+            
+        case ADDR_INDIRECT:
+            
+            return mem.isIO(addr) || mem.isIO((addr & 0xFF00) | (u8)(addr + 1));
+            
+        case ADDR_RELATIVE:
+            
+            addr = pc + 2;
+            target = addr + (i8)lo;
+            break;
+            
+        default:
+            
+            // All other instructions only access the stack and zero page
+            return false;
+    }
+    
+    // Indexed and branch instructions may access the wrong page first
+    return mem.isIO(target) || mem.isIO((addr & 0xFF00) | (target & 0xFF));
+}
+
 /*
 bool
 VC1541::execute(u64 duration)
@@ -169,9 +261,9 @@ VC1541::execute(u64 duration)
     if (nextClock < elapsedTime) {
         // Execute CPU and VIAs
         u64 cycle = ++cpu.cycle;
-        if (cycle >= via1.wakeUpCycle) via1.execute(); else via1.idleCounter++;
-        if (cycle >= via2.wakeUpCycle) via2.execute(); else via2.idleCounter++;
-        result = cpu.executeOneCycle();
+        if (cycle >= via1.wakeUpCycle) via1.execute();
+        if (cycle >= via2.wakeUpCycle) via2.execute();
+        result = cpu.executeCycle<VC1541Memory>();
         nextClock += 10000;
     }
     
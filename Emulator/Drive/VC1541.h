@@ -97,6 +97,20 @@ private:
     //! @brief    Indicates whether the drive shall send sound notifications.
     bool sendSoundMessages;
     
+    /*! @brief    Indicates whether quiet phases are emulated per instruction
+     *  @details  If enabled, the drive CPU executes a complete instruction at
+     *            once if it can't interact with the rest of the drive. In that
+     *            case, the disk is standing still, both VIAs are asleep, and
+     *            the instruction does not access the I/O space.
+     *  @note     The fast path is disabled by default, because it is not
+     *            fully cycle-exact. An IEC change caused by the C64 while an
+     *            instruction is executed in one go reaches VIA 1 when the
+     *            instruction has completed. E.g., an ATN interrupt may be
+     *            triggered one instruction late.
+     *  @seealso  isQuiet()
+     */
+    bool fastPath;
+    
     
     //
     // Clocking logic
@@ -247,6 +261,12 @@ public:
     //! @brief    Enables or disables sending of sound messages.
     void setSendSoundMessages(bool b) { sendSoundMessages = b; }
 
+    //! @brief    Returns true if quiet phases are emulated per instruction.
+    bool fastPathEnabled() { return fastPath; }
+    
+    //! @brief    Enables or disables instruction-wise emulation of quiet phases.
+    void setFastPath(bool b) { fastPath = b; }
+
     
     //
     //! @functiongroup Working with the drive
@@ -373,6 +393,16 @@ public:
 
 private:
     
+    /*! @brief    Checks whether the next instruction can be run in one go
+     *  @details  This is the case if the CPU is about to fetch an instruction
+     *            that can't interact with the VIAs, the disk, or the IEC bus
+     *            before it has completed.
+     */
+    bool isQuiet();
+    
+    //! @brief    Returns true if the next instruction may access the I/O space
+    bool nextInstructionAccessesIO();
+    
     //! @brief   Emulates a trigger event on the carry output pin of UE7.
     void executeUF4();
     
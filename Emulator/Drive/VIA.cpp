@@ -47,7 +47,8 @@ VIA6522::VIA6522(VC1541 *drive, C64 &ref) : C64Component(ref)
         { &feed,            sizeof(feed),           CLEAR_ON_RESET },
         { &tiredness,       sizeof(tiredness),      CLEAR_ON_RESET },
         { &wakeUpCycle,     sizeof(wakeUpCycle),    CLEAR_ON_RESET },
-        { &idleCounter,     sizeof(idleCounter),    CLEAR_ON_RESET },
+        { &sleeping,        sizeof(sleeping),       CLEAR_ON_RESET },
+        { &sleepCycle,      sizeof(sleepCycle),     CLEAR_ON_RESET },
         { NULL,             0,                      0 }};
     
     registerSnapshotItems(items, sizeof(items));
@@ -112,7 +113,7 @@ VIA6522::isVia2()
 void
 VIA6522::execute()
 {
-    wakeUp();
+    wakeUp(drive->cpu.cycle - 1);
     
     u64 oldDelay = delay;
     u64 oldFeed  = feed;
@@ -222,7 +223,7 @@ VIA6522::peek(u16 addr)
 {
 	assert (addr <= 0xF);
 		
-    wakeUp();
+    wakeUp(drive->cpu.cycle - 1);
     
 	switch(addr) {
             
@@ -437,7 +438,7 @@ void VIA6522::poke(u16 addr, u8 value)
 {
     assert (addr <= 0x0F);
     
-    wakeUp();
+    wakeUp(drive->cpu.cycle - 1);
     
     switch(addr) {
             
@@ -832,25 +833,29 @@ VIA6522::CA1action(bool value)
 void
 VIA6522::sleep()
 {
-    assert(idleCounter == 0);
+    assert(!sleeping);
     
     // Determine maximum possible sleep cycles based on timer counts
     u64 sleepA = (t1 > 2) ? (drive->cpu.cycle + t1 - 1) : 0;
     u64 sleepB = (t2 > 2) ? (drive->cpu.cycle + t2 - 1) : 0;
     
     // VIAs with stopped timers can sleep forever
-    if (!(delay & VIACountA1)) sleepA = UINT64_MAX;
-    if (!(delay & VIACountB1)) sleepB = UINT64_MAX;
+    if (!(delay & VIACountA1)) sleepA = NEVER;
+    if (!(delay & VIACountB1)) sleepB = NEVER;
     
+    sleeping = true;
+    sleepCycle = drive->cpu.cycle;
     wakeUpCycle = MIN(sleepA, sleepB);
 }
 
 void
-VIA6522::wakeUp()
+VIA6522::wakeUp(u64 targetCycle)
 {
-    u64 idleCycles = idleCounter;
+    if (!sleeping)
+        return;
     
     // Make up for missed cycles
+    u64 idleCycles = (targetCycle > sleepCycle) ? targetCycle - sleepCycle : 0;
     if (idleCycles) {
         if (delay & VIACountA1) {
             assert((delay & (VIACountA0)) != 0);
@@ -870,11 +875,17 @@ VIA6522::wakeUp()
             assert((delay & (VIACountB0)) == 0);
             assert((feed & (VIACountB0)) == 0);
         }
-        idleCounter = 0;
     }
+    sleeping = false;
     wakeUpCycle = 0;
 }
 
+void
+VIA6522::wakeUp()
+{
+    wakeUp(drive->cpu.cycle);
+}
+
 
 //
 // VIA 1
@@ -228,8 +228,11 @@ class VIA6522 : public C64Component {
     //! @brief    Wakeup cycle
     u64 wakeUpCycle;
     
-    //! @brief    Number of skipped executions
-    u64 idleCounter;
+    //! @brief    Indicates if the VIA is currently in idle state
+    bool sleeping;
+    
+    //! @brief    The cycle in which the VIA went into idle state
+    u64 sleepCycle;
     
 public:
     
@@ -509,7 +512,10 @@ public:
     //! @brief    Puts the VIA into idle state.
     void sleep();
     
-    //! @brief    Emulates all previously skipped cycles.
+    /*! @brief    Emulates all previously skipped cycles.
+     *  @param    targetCycle is the last cycle that has been skipped.
+     */
+    void wakeUp(u64 targetCycle);
     void wakeUp();
 };
 
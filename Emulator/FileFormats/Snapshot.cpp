@@ -8,6 +8,8 @@
 // -----------------------------------------------------------------------------
 
 #include "C64.h"
+#include <algorithm>
+#include <climits>
 
 const u8 Snapshot::magicBytes[] = { 'V', 'C', '6', '4' };
 
@@ -95,6 +97,10 @@ Snapshot::Snapshot(size_t capacity)
     header->minor = V_MINOR;
     header->subminor = V_SUBMINOR;
     header->timestamp = time(NULL);
+    header->screenshot.width = 0;
+    header->screenshot.height = 0;
+    header->screenshot.size = 0;
+    header->blobBytes = 0;
 }
 
 Snapshot *
@@ -129,43 +135,338 @@ Snapshot::makeWithC64(C64 *c64)
     Snapshot *snapshot;
     
     snapshot = new Snapshot(c64->stateSize());
-    snapshot->takeScreenshot(c64);
-    u8 *ptr = snapshot->getData();
-    c64->saveToBuffer(&ptr);
+    snapshot->takeState(c64);
     
     return snapshot;
 }
 
+Snapshot *
+Snapshot::makeWithDelta(Snapshot *snapshot,
+                        std::shared_ptr<Snapshot> keyframe,
+                        const vector<bool> *candidates)
+{
+    assert(!snapshot->isDelta() && !keyframe->isDelta());
+    assert(snapshot->size == keyframe->size);
+
+    Snapshot *delta = new Snapshot();
+    delta->keyframe = keyframe;
+    delta->blobs = snapshot->blobs;
+    delta->screenshot = snapshot->screenshot;
+    
+    // Collect all pages that differ from the keyframe
+    for (size_t offset = 0; offset < snapshot->size; offset += PAGE_SIZE) {
+        
+        if (candidates && !(*candidates)[offset / PAGE_SIZE]) continue;
+        
+        size_t len = MIN(PAGE_SIZE, snapshot->size - offset);
+        if (memcmp(snapshot->data + offset, keyframe->data + offset, len)) {
+            delta->pages.push_back((u32)(offset / PAGE_SIZE));
+        }
+    }
+    
+    // Copy the page contents
+    delta->pageData = new u8[delta->pages.size() * PAGE_SIZE];
+    u8 *ptr = delta->pageData;
+    for (auto page : delta->pages) {
+        
+        size_t offset = page * PAGE_SIZE;
+        size_t len = MIN(PAGE_SIZE, snapshot->size - offset);
+        memcpy(ptr, snapshot->data + offset, len);
+        ptr += PAGE_SIZE;
+    }
+    
+    return delta;
+}
+
+Snapshot::~Snapshot()
+{
+    delete[] pageData;
+    delete[] image;
+}
+
 bool 
 Snapshot::hasSameType(const char *filename)
 {
     return Snapshot::isSnapshotFile(filename, V_MAJOR, V_MINOR, V_SUBMINOR);
 }
 
+bool
+Snapshot::readFromBuffer(const u8 *buffer, size_t length)
+{
+    if (!AnyC64File::readFromBuffer(buffer, length))
+        return false;
+    
+    if (size < sizeof(SnapshotHeader))
+        return true;
+    
+    SnapshotHeader *header = (SnapshotHeader *)data;
+    size_t appended = (size_t)header->screenshot.size + header->blobBytes;
+    if (appended > size - sizeof(SnapshotHeader))
+        return false;
+    
+    // Extract the screenshot
+    u8 *ptr = data + size - appended;
+    screenshot.assign(ptr, ptr + header->screenshot.size);
+    
+    // Move the blob section into the blob store
+    ptr += header->screenshot.size;
+    u8 *end = data + size;
+    while (ptr < end) {
+        
+        if (end - ptr < 12) return false;
+        u64 fingerprint = read64(&ptr);
+        u32 blobSize = read32(&ptr);
+        if ((size_t)(end - ptr) < blobSize) return false;
+        
+        BlobRef blob = BlobStore::intern(ptr, blobSize);
+        if (blob->fingerprint != fingerprint) {
+            warn("Blob %llx is corrupted\n", fingerprint);
+            return false;
+        }
+        blobs.push_back(blob);
+        ptr += blobSize;
+    }
+    
+    size -= appended;
+    eof = size;
+    header->screenshot.size = 0;
+    header->blobBytes = 0;
+    return true;
+}
+
+size_t
+Snapshot::writeToBuffer(u8 *buffer)
+{
+    size_t stateSize = fullSize();
+    size_t blobBytes = 0;
+    for (auto &blob : blobs) blobBytes += 12 + blob->size;
+    
+    if (buffer) {
+        
+        // Delta snapshots are reconstructed in place and stay deltas
+        SnapshotHeader *header = (SnapshotHeader *)buffer;
+        restore(buffer);
+        header->screenshot.size = (u32)screenshot.size();
+        header->blobBytes = (u32)blobBytes;
+        
+        // Append the screenshot and all referenced blobs
+        u8 *ptr = buffer + stateSize;
+        writeBlock(&ptr, screenshot.data(), screenshot.size());
+        for (auto &blob : blobs) {
+            write64(&ptr, blob->fingerprint);
+            write32(&ptr, (u32)blob->size);
+            writeBlock(&ptr, blob->data, blob->size);
+        }
+    }
+    return stateSize + screenshot.size() + blobBytes;
+}
+
+size_t
+Snapshot::footprint()
+{
+    size_t result = isDelta() ? pages.size() * (PAGE_SIZE + sizeof(u32)) : size;
+    return result + screenshot.size();
+}
+
+void
+Snapshot::restore(u8 *buffer)
+{
+    if (!isDelta()) {
+        memcpy(buffer, data, size);
+        return;
+    }
+    
+    size_t total = keyframe->size;
+    memcpy(buffer, keyframe->data, total);
+    
+    u8 *ptr = pageData;
+    for (auto page : pages) {
+        
+        size_t offset = page * PAGE_SIZE;
+        memcpy(buffer + offset, ptr, MIN(PAGE_SIZE, total - offset));
+        ptr += PAGE_SIZE;
+    }
+}
+
+void
+Snapshot::expand()
+{
+    if (!isDelta()) return;
+    
+    size = keyframe->size;
+    data = new u8[size];
+    restore(data);
+    
+    keyframe.reset();
+    pages.clear();
+    delete[] pageData;
+    pageData = NULL;
+}
+
+void
+Snapshot::takeState(C64 *c64)
+{
+    assert(!isDelta());
+    assert(size == sizeof(SnapshotHeader) + c64->stateSize());
+    
+    getHeader()->timestamp = time(NULL);
+    takeScreenshot(c64);
+    u8 *ptr = getData();
+    c64->saveToBuffer(&ptr);
+    takeBlobs(c64);
+}
+
+void
+Snapshot::updateState(C64 *c64, vector<bool> &dirty)
+{
+    assert(!isDelta());
+    assert(size == sizeof(SnapshotHeader) + c64->stateSize());
+    assert(dirty.size() == (size + PAGE_SIZE - 1) / PAGE_SIZE);
+    
+    // The header is always rewritten
+    getHeader()->timestamp = time(NULL);
+    takeScreenshot(c64);
+    for (size_t i = 0; i * PAGE_SIZE < sizeof(SnapshotHeader); i++) {
+        dirty[i] = true;
+    }
+    
+    u8 *ptr = getData();
+    c64->updateBuffer(&ptr, data, dirty, PAGE_SIZE);
+    takeBlobs(c64);
+}
+
+void
+Snapshot::takeBlobs(C64 *c64)
+{
+    blobs.clear();
+    c64->collectBlobs(blobs);
+    
+    // Remove duplicates (e.g., empty halftracks or identical drive ROMs)
+    std::sort(blobs.begin(), blobs.end(), [](const BlobRef &a, const BlobRef &b) {
+        return a->fingerprint < b->fingerprint; });
+    blobs.erase(std::unique(blobs.begin(), blobs.end()), blobs.end());
+}
+
+const SnapshotHeader *
+Snapshot::peekHeader()
+{
+    if (!isDelta()) return (SnapshotHeader *)data;
+    
+    // The header is located in the first page
+    if (!pages.empty() && pages[0] == 0) return (SnapshotHeader *)pageData;
+    return (SnapshotHeader *)keyframe->data;
+}
+
+unsigned char *
+Snapshot::getImageData()
+{
+    if (image) return (unsigned char *)image;
+    
+    const SnapshotHeader *header = peekHeader();
+    size_t numPixels = header->screenshot.width * header->screenshot.height;
+    image = new u32[numPixels];
+    
+    // Decode the run-length encoded image
+    size_t pos = 0;
+    for (auto byte : screenshot) {
+        
+        u32 color = header->screenshot.palette[byte & 0x0F];
+        for (unsigned i = 0; i <= (byte >> 4) && pos < numPixels; i++) {
+            image[pos++] = color;
+        }
+    }
+    while (pos < numPixels) image[pos++] = 0;
+    
+    return (unsigned char *)image;
+}
+
+/*! @brief    Returns the palette index of a color
+ *  @details  Colors are added to the palette in the order of appearance.
+ *            The VIC only emits 16 colors, so the palette does not overflow
+ *            in practice. If it does, the closest color is used.
+ */
+static u8
+paletteIndex(u32 color, u32 *palette, unsigned &numColors)
+{
+    for (unsigned i = 0; i < numColors; i++) {
+        if (palette[i] == color) return (u8)i;
+    }
+    if (numColors < 16) {
+        palette[numColors] = color;
+        return (u8)numColors++;
+    }
+    
+    u8 result = 0;
+    long best = LONG_MAX;
+    for (unsigned i = 0; i < 16; i++) {
+        long distance = 0;
+        for (unsigned shift = 0; shift < 24; shift += 8) {
+            long delta = (long)((color >> shift) & 0xFF) - (long)((palette[i] >> shift) & 0xFF);
+            distance += delta * delta;
+        }
+        if (distance < best) { best = distance; result = (u8)i; }
+    }
+    return result;
+}
+
 void
 Snapshot::takeScreenshot(C64 *c64)
 {
     SnapshotHeader *header = (SnapshotHeader *)data;
-    unsigned x_start, y_start;
+    unsigned x_start, y_start, width, height;
        
     if (c64->vic.isPAL()) {
         x_start = PAL_LEFT_BORDER_WIDTH - 36;
         y_start = PAL_UPPER_BORDER_HEIGHT - 34;
-        header->screenshot.width = 36 + PAL_CANVAS_WIDTH + 36;
-        header->screenshot.height = 34 + PAL_CANVAS_HEIGHT + 34;
+        width = 36 + PAL_CANVAS_WIDTH + 36;
+        height = 34 + PAL_CANVAS_HEIGHT + 34;
     } else {
         x_start = NTSC_LEFT_BORDER_WIDTH - 42;
         y_start = NTSC_UPPER_BORDER_HEIGHT - 9;
-        header->screenshot.width = 36 + PAL_CANVAS_WIDTH + 36;
-        header->screenshot.height = 9 + PAL_CANVAS_HEIGHT + 9;
+        width = 36 + PAL_CANVAS_WIDTH + 36;
+        height = 9 + PAL_CANVAS_HEIGHT + 9;
     }
+    header->screenshot.width = width / SCREENSHOT_SCALE;
+    header->screenshot.height = height / SCREENSHOT_SCALE;
+    header->screenshot.size = 0;
+    
+    u8 *source = c64->vic.stableIndexBuffer();
+    u32 *palette = header->screenshot.palette;
+    unsigned numColors = 0;
+    memset(palette, 0, sizeof(header->screenshot.palette));
     
-    u32 *source = (u32 *)c64->vic.screenBuffer();
-    u32 *target = header->screenshot.screen;
+    // Encode the image
+    u32 lastColor = 0;
+    u8 index = 0, runIndex = 0, runLength = 0;
+    screenshot.clear();
     source += x_start + y_start * NTSC_PIXELS;
-    for (unsigned i = 0; i < header->screenshot.height; i++) {
-        memcpy(target, source, header->screenshot.width * 4);
-        target += header->screenshot.width;
-        source += NTSC_PIXELS;
+    for (unsigned y = 0; y < header->screenshot.height; y++) {
+        
+        u8 *line = source + y * SCREENSHOT_SCALE * NTSC_PIXELS;
+        for (unsigned x = 0; x < header->screenshot.width; x++) {
+            
+            u32 color = c64->vic.getColor(line[x * SCREENSHOT_SCALE]);
+            if (color != lastColor || numColors == 0) {
+                index = paletteIndex(color, palette, numColors);
+                lastColor = color;
+            }
+            
+            if (runLength > 0 && runLength < 16 && index == runIndex) {
+                runLength++;
+                continue;
+            }
+            if (runLength > 0) {
+                screenshot.push_back((u8)((runLength - 1) << 4 | runIndex));
+            }
+            runIndex = index;
+            runLength = 1;
+        }
     }
+    if (runLength > 0) {
+        screenshot.push_back((u8)((runLength - 1) << 4 | runIndex));
+    }
+    
+    // Discard the previously decoded image
+    delete[] image;
+    image = NULL;
 }
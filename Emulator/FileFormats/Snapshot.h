@@ -11,6 +11,8 @@
 #define _SNAPSHOT_INC
 
 #include "AnyC64File.h"
+#include "BlobStore.h"
+#include <memory>
 
 // Forward declarations
 class C64;
@@ -26,20 +28,40 @@ typedef struct {
     u8 minor;
     u8 subminor;
     
-    //! @brief    Screenshot
+    /*! @brief    Screenshot
+     *  @details  The screenshot is downscaled, stored with one palette index
+     *            per pixel, and run-length encoded. Each byte of the encoded
+     *            image describes a run of up to 16 pixels. The upper nibble
+     *            holds the run length minus one and the lower nibble holds
+     *            the color index. The encoded data is not part of the header.
+     *            It is appended to the emulator state in snapshot files.
+     */
     struct {
         
         //! @brief    Image width and height
         u16 width, height;
         
-        //! @brief    Screen buffer data
-        u32 screen[PAL_RASTERLINES * NTSC_PIXELS];
+        //! @brief    RGBA values of all color indices
+        u32 palette[16];
+        
+        /*! @brief    Size of the encoded image in bytes
+         *  @details  Only set in snapshot files. In memory, the encoded image
+         *            is kept outside the snapshot data and this value is 0.
+         */
+        u32 size;
         
     } screenshot;
     
     //! @brief    Date and time of snapshot creation
     time_t timestamp;
     
+    /*! @brief    Size of the blob section in bytes
+     *  @details  Snapshot files end with all blobs referenced by the stored
+     *            state. In memory, the blobs are kept in the blob store and
+     *            this value is 0.
+     */
+    u32 blobBytes;
+    
 } SnapshotHeader;
 
 
@@ -54,6 +76,44 @@ class Snapshot : public AnyC64File {
     //! @brief    Header signature
     static const u8 magicBytes[];
     
+public:
+    
+    //! @brief    Granularity of delta snapshots in bytes
+    static const size_t PAGE_SIZE = 256;
+    
+    //! @brief    Downscaling factor of the stored screenshot
+    static const unsigned SCREENSHOT_SCALE = 2;
+    
+private:
+    
+    /*! @brief    Reference snapshot of a delta snapshot
+     *  @details  A delta snapshot only stores the pages that differ from its
+     *            keyframe. For all other snapshots, this pointer is NULL.
+     *            Keyframes are shared by all delta snapshots referring to them
+     *            and are deleted together with the last one.
+     */
+    std::shared_ptr<Snapshot> keyframe;
+    
+    //! @brief    Page numbers of all pages stored in a delta snapshot
+    vector<u32> pages;
+    
+    //! @brief    Contents of all pages stored in a delta snapshot
+    u8 *pageData = NULL;
+    
+    /*! @brief    Blobs referenced by the stored state
+     *  @details  ROM images and disk data are stored as fingerprints. The
+     *            snapshot keeps the referenced blobs alive and appends them
+     *            when it is written to a file.
+     *  @seealso  BlobStore
+     */
+    BlobList blobs;
+    
+    //! @brief    Run-length encoded screenshot
+    vector<u8> screenshot;
+    
+    //! @brief    Decoded screenshot (created on demand)
+    u32 *image = NULL;
+    
     
     //
     //! @functiongroup Class methods
@@ -109,6 +169,19 @@ class Snapshot : public AnyC64File {
     //! @brief    Factory method
     static Snapshot *makeWithC64(C64 *c64);
     
+    /*! @brief    Factory method
+     *  @details  Creates a delta snapshot containing all pages of snapshot that
+     *            differ from keyframe. Both snapshots must have the same size.
+     *  @param    candidates If provided, only pages marked in this page map
+     *            are compared. All others are assumed to match the keyframe.
+     */
+    static Snapshot *makeWithDelta(Snapshot *snapshot,
+                                   std::shared_ptr<Snapshot> keyframe,
+                                   const vector<bool> *candidates = NULL);
+    
+    //! @brief    Destructor
+    ~Snapshot();
+    
     
     //
     //! @functiongroup Methods from AnyC64File
@@ -117,6 +190,34 @@ class Snapshot : public AnyC64File {
     C64FileType type() { return V64_FILE; }
     const char *typeAsString() { return "V64"; }
     bool hasSameType(const char *filename);
+    bool readFromBuffer(const u8 *buffer, size_t length);
+    size_t writeToBuffer(u8 *buffer);
+    
+    
+    //
+    //! @functiongroup Handling delta snapshots
+    //
+    
+    //! @brief    Returns true if this snapshot only stores differences to a keyframe
+    bool isDelta() { return keyframe.get() != NULL; }
+    
+    //! @brief    Returns the keyframe of a delta snapshot or NULL
+    Snapshot *getKeyframe() { return keyframe.get(); }
+    
+    //! @brief    Returns the number of bytes stored in this snapshot
+    size_t footprint();
+    
+    //! @brief    Returns the size of the reconstructed snapshot
+    size_t fullSize() { return isDelta() ? keyframe->size : size; }
+    
+    /*! @brief    Reconstructs the full snapshot
+     *  @details  buffer must provide space for the complete snapshot including
+     *            the header. This function does not alter the snapshot.
+     */
+    void restore(u8 *buffer);
+    
+    //! @brief    Converts a delta snapshot into a full snapshot
+    void expand();
     
     
     //
@@ -126,26 +227,55 @@ class Snapshot : public AnyC64File {
     public:
     
     //! @brief    Returns pointer to header data
-    SnapshotHeader *getHeader() { return (SnapshotHeader *)data; }
+    SnapshotHeader *getHeader() { expand(); return (SnapshotHeader *)data; }
+    
+    /*! @brief    Returns pointer to header data for reading
+     *  @details  Unlike getHeader(), this function does not expand delta
+     *            snapshots.
+     */
+    const SnapshotHeader *peekHeader();
     
     //! @brief    Returns pointer to core data
-    u8 *getData() { return data + sizeof(SnapshotHeader); }
+    u8 *getData() { expand(); return data + sizeof(SnapshotHeader); }
     
     //! @brief    Returns the timestamp
-    time_t getTimestamp() { return getHeader()->timestamp; }
+    time_t getTimestamp() { return peekHeader()->timestamp; }
+    
+    //! @brief    Returns the blobs referenced by the stored state
+    const BlobList &getBlobs() { return blobs; }
         
-    //! @brief    Returns a pointer to the screenshot data.
-    unsigned char *getImageData() { return (unsigned char *)(getHeader()->screenshot.screen); }
+    /*! @brief    Returns a pointer to the screenshot data.
+     *  @details  The screenshot is decoded into RGBA format on the first call.
+     */
+    unsigned char *getImageData();
     
     //! @brief    Returns the screenshot image width
-    unsigned getImageWidth() { return getHeader()->screenshot.width; }
+    unsigned getImageWidth() { return peekHeader()->screenshot.width; }
     
     //! @brief    Returns the screenshot image height
-    unsigned getImageHeight() { return getHeader()->screenshot.height; }
+    unsigned getImageHeight() { return peekHeader()->screenshot.height; }
     
-    //! @brief    Stores a screenshot inside this snapshot
+    //! @brief    Stores a downscaled screenshot inside this snapshot
     void takeScreenshot(C64 *c64);
     
+    /*! @brief    Stores the current emulator state inside this snapshot
+     *  @details  The snapshot must have been created with a capacity matching
+     *            the state size of the emulator.
+     */
+    void takeState(C64 *c64);
+    
+    /*! @brief    Brings the stored emulator state up to date
+     *  @details  Unlike takeState(), this function only rewrites components
+     *            whose state has changed since the last call. All rewritten
+     *            pages are marked in the dirty map.
+     *  @seealso  HardwareComponent::updateBuffer()
+     */
+    void updateState(C64 *c64, vector<bool> &dirty);
+    
+private:
+    
+    //! @brief    Records all blobs referenced by the emulator state
+    void takeBlobs(C64 *c64);
 };
 
 #endif
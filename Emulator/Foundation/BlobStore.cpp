@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "BlobStore.h"
+
+pthread_mutex_t BlobStore::lock = PTHREAD_MUTEX_INITIALIZER;
+std::unordered_map<u64, std::weak_ptr<const Blob>> BlobStore::blobs;
+
+Blob::Blob(u64 fingerprint, const u8 *data, size_t size)
+{
+    this->fingerprint = fingerprint;
+    this->size = size;
+    this->data = new u8[size];
+    memcpy(this->data, data, size);
+}
+
+Blob::~Blob()
+{
+    delete[] data;
+}
+
+BlobRef
+BlobStore::intern(const u8 *data, size_t size)
+{
+    u64 fingerprint = fnv_1a_64((u8 *)data, size);
+    BlobRef result;
+
+    // Note: result must not be released while the lock is held, because the
+    // deleter of the last reference acquires the lock, too.
+    pthread_mutex_lock(&lock);
+
+    auto it = blobs.find(fingerprint);
+    if (it != blobs.end()) result = it->second.lock();
+
+    if (result && (result->size != size || memcmp(result->data, data, size))) {
+
+        // Hash collision. Hand out a private blob that is not registered
+        pthread_mutex_unlock(&lock);
+        result.reset();
+        return BlobRef(new Blob(fingerprint, data, size), release);
+    }
+
+    if (!result) {
+        result = BlobRef(new Blob(fingerprint, data, size), release);
+        blobs[fingerprint] = result;
+    }
+
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+BlobRef
+BlobStore::lookup(u64 fingerprint)
+{
+    BlobRef result;
+
+    pthread_mutex_lock(&lock);
+    auto it = blobs.find(fingerprint);
+    if (it != blobs.end()) result = it->second.lock();
+    pthread_mutex_unlock(&lock);
+
+    return result;
+}
+
+u64
+BlobStore::refresh(BlobRef &ref, const u8 *data, size_t size)
+{
+    if (!ref || ref->size != size || memcmp(ref->data, data, size)) {
+        ref = intern(data, size);
+    }
+    return ref->fingerprint;
+}
+
+bool
+BlobStore::restore(u64 fingerprint, const BlobList *blobs,
+                   BlobRef &ref, u8 *data, size_t size)
+{
+    BlobRef blob;
+    
+    if (blobs) {
+        for (auto &it : *blobs) {
+            if (it->fingerprint == fingerprint && it->size == size) { blob = it; break; }
+        }
+    }
+    if (!blob) blob = lookup(fingerprint);
+    
+    if (!blob || blob->size != size) return false;
+    
+    memcpy(data, blob->data, size);
+    ref = blob;
+    return true;
+}
+
+size_t
+BlobStore::count()
+{
+    size_t result = 0;
+
+    pthread_mutex_lock(&lock);
+    for (auto &it : blobs) if (!it.second.expired()) result++;
+    pthread_mutex_unlock(&lock);
+
+    return result;
+}
+
+size_t
+BlobStore::footprint()
+{
+    size_t result = 0;
+    BlobList live;
+
+    // Blobs must not be released while the lock is held
+    pthread_mutex_lock(&lock);
+    for (auto &it : blobs) {
+        BlobRef blob = it.second.lock();
+        if (blob) live.push_back(blob);
+    }
+    pthread_mutex_unlock(&lock);
+
+    for (auto &blob : live) result += blob->size;
+    return result;
+}
+
+void
+BlobStore::release(Blob *blob)
+{
+    pthread_mutex_lock(&lock);
+
+    // Remove the entry unless it has been replaced by a new blob already
+    auto it = blobs.find(blob->fingerprint);
+    if (it != blobs.end() && it->second.expired()) blobs.erase(it);
+
+    pthread_mutex_unlock(&lock);
+    delete blob;
+}
@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _BLOBSTORE_INC
+#define _BLOBSTORE_INC
+
+#include "basic.h"
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+/*! @brief    An immutable chunk of data
+ *  @details  Blobs are identified by the FNV-1a fingerprint of their content.
+ */
+struct Blob {
+
+    u64 fingerprint;
+    size_t size;
+    u8 *data;
+
+    Blob(u64 fingerprint, const u8 *data, size_t size);
+    ~Blob();
+};
+
+typedef std::shared_ptr<const Blob> BlobRef;
+typedef std::vector<BlobRef> BlobList;
+
+
+/*! @brief    Content-addressed storage for large, rarely changing data
+ *  @details  Snapshots do not store ROM images and disk halftracks directly.
+ *            They store the fingerprint of the data instead and keep the
+ *            data itself in this store. A blob stays in the store as long as
+ *            a reference to it exists. The store is shared by all emulator
+ *            instances of the process, so identical ROMs and disks are kept
+ *            only once.
+ */
+class BlobStore {
+
+    //! @brief    Mutex protecting the blob map
+    static pthread_mutex_t lock;
+
+    //! @brief    All blobs that are currently referenced
+    static std::unordered_map<u64, std::weak_ptr<const Blob>> blobs;
+
+public:
+
+    /*! @brief    Returns a blob holding the specified data
+     *  @details  If a blob with the same content exists, it is returned.
+     *            Otherwise, a new blob is created.
+     */
+    static BlobRef intern(const u8 *data, size_t size);
+
+    //! @brief    Returns the blob with the specified fingerprint or NULL
+    static BlobRef lookup(u64 fingerprint);
+
+    /*! @brief    Returns the fingerprint of the specified data
+     *  @details  ref is a cached reference to a blob that held this data at
+     *            some earlier time. It is replaced if the data has changed
+     *            in the meantime.
+     */
+    static u64 refresh(BlobRef &ref, const u8 *data, size_t size);
+
+    /*! @brief    Copies the content of a blob into a buffer
+     *  @details  The blob is searched in the specified list first, which is
+     *            usually the list of a snapshot that is being loaded. If it
+     *            is not found there, the store is searched. On success, ref
+     *            is set to the blob. If no blob with the specified fingerprint
+     *            and size exists, the buffer is left untouched and false is
+     *            returned.
+     *  @param    blobs   List to search first (may be NULL)
+     */
+    static bool restore(u64 fingerprint, const BlobList *blobs,
+                        BlobRef &ref, u8 *data, size_t size);
+
+    //! @brief    Returns the number of blobs in the store
+    static size_t count();
+
+    //! @brief    Returns the number of bytes stored in all blobs
+    static size_t footprint();
+
+private:
+
+    //! @brief    Deleter of all blobs handed out by the store
+    static void release(Blob *blob);
+};
+
+#endif
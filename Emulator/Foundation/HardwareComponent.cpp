@@ -181,20 +181,61 @@ HardwareComponent::loadFromBuffer(u8 **buffer)
     }
 }
 
+void
+HardwareComponent::collectBlobs(BlobList &blobs)
+{
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            subComponents[i]->collectBlobs(blobs);
+}
+
 void
 HardwareComponent::saveToBuffer(u8 **buffer)
+{
+    saveState(buffer, NULL, NULL, 0);
+}
+
+void
+HardwareComponent::updateBuffer(u8 **buffer, const u8 *origin, vector<bool> &dirty, size_t pageSize)
+{
+    saveState(buffer, origin, &dirty, pageSize);
+}
+
+//! @brief    Marks all pages overlapping the range [from, to) as dirty
+static void
+markPages(const u8 *origin, const u8 *from, const u8 *to, vector<bool> *dirty, size_t pageSize)
+{
+    if (dirty == NULL || from == to) return;
+    
+    size_t first = (from - origin) / pageSize;
+    size_t last = (to - origin - 1) / pageSize;
+    for (size_t i = first; i <= last; i++) (*dirty)[i] = true;
+}
+
+void
+HardwareComponent::saveState(u8 **buffer, const u8 *origin, vector<bool> *dirty, size_t pageSize)
 {
     u8 *old = *buffer;
     
+    // Skip unchanged components in incremental mode
+    if (dirty && !stateChanged()) {
+        *buffer += stateSize();
+        return;
+    }
+    
     debug(SNP_DEBUG, "    Saving internal state ...\n");
 
     // Call delegation method
     willSaveToBuffer(buffer);
     
     // Save internal state of all sub components
+    u8 *mark = *buffer;
     if (subComponents != NULL) {
-        for (unsigned i = 0; subComponents[i] != NULL; i++)
-            subComponents[i]->saveToBuffer(buffer);
+        for (unsigned i = 0; subComponents[i] != NULL; i++) {
+            markPages(origin, mark, *buffer, dirty, pageSize);
+            subComponents[i]->saveState(buffer, origin, dirty, pageSize);
+            mark = *buffer;
+        }
     }
     
     // Save own internal state
@@ -229,6 +270,8 @@ HardwareComponent::saveToBuffer(u8 **buffer)
     
     // Call delegation method
     didSaveToBuffer(buffer);
+    markPages(origin, mark, *buffer, dirty, pageSize);
+    if (dirty) stateUpdated();
     
     // Verify that the number of written bytes matches the state size
     if (*buffer - old != stateSize()) {
@@ -11,6 +11,7 @@
 #define _HARDWARE_COMPONENT_INC
 
 #include "C64Object.h"
+#include "BlobStore.h"
 
 typedef enum
 {
@@ -219,6 +220,42 @@ public:
      */
     virtual void  willSaveToBuffer(u8 **buffer) { };
     virtual void  didSaveToBuffer(u8 **buffer) { };
+    
+    /*! @brief    Brings a previously saved state up to date
+     *  @details  Works like saveToBuffer(), but skips all components that
+     *            report an unchanged state. Hence, the buffer must contain the
+     *            state written by the previous call. All rewritten pages are
+     *            marked in the dirty map.
+     *  @param    origin Start of the buffer. Page numbers are relative to it.
+     *  @param    dirty Page map with one entry for each page of the buffer.
+     *  @param    pageSize Number of bytes covered by a single page.
+     */
+    void updateBuffer(u8 **buffer, const u8 *origin, vector<bool> &dirty, size_t pageSize);
+    
+    /*! @brief    Indicates whether the state has changed since the last call
+     *            to updateBuffer()
+     *  @details  By default, the state is considered to be changed all the
+     *            time. Components with a large but rarely changing state
+     *            overwrite this method to speed up updateBuffer().
+     */
+    virtual bool stateChanged() { return true; }
+    
+    //! @brief    Called by updateBuffer() after the state has been rewritten
+    virtual void stateUpdated() { };
+    
+    /*! @brief    Collects all blobs referenced by the saved state
+     *  @details  Components that save fingerprints instead of large data
+     *            chunks add the referenced blobs to the list. A snapshot
+     *            keeps these blobs alive for as long as it exists. By default,
+     *            the function is called for all sub components.
+     *  @seealso  BlobStore
+     */
+    virtual void collectBlobs(BlobList &blobs);
+    
+private:
+    
+    //! @brief    Work horse for saveToBuffer() and updateBuffer()
+    void saveState(u8 **buffer, const u8 *origin, vector<bool> *dirty, size_t pageSize);
 };
 
 #endif
@@ -314,24 +314,69 @@ sleepMicrosec(unsigned usec)
 	}
 }
 
+#ifdef __MACH__
+
+//! @brief    Conversion factors between kernel time and nanoseconds
+static mach_timebase_info_data_t timebase()
+{
+    static mach_timebase_info_data_t tb;
+    if (tb.denom == 0) mach_timebase_info(&tb);
+    return tb;
+}
+
+u64
+monotonicNanos()
+{
+    mach_timebase_info_data_t tb = timebase();
+    return mach_absolute_time() * tb.numer / tb.denom;
+}
+
+static void
+sleepUntilNanos(u64 nanoTargetTime)
+{
+    mach_timebase_info_data_t tb = timebase();
+    mach_wait_until(nanoTargetTime * tb.denom / tb.numer);
+}
+
+#else
+
+u64
+monotonicNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000 + (u64)ts.tv_nsec;
+}
+
+static void
+sleepUntilNanos(u64 nanoTargetTime)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(nanoTargetTime / 1000000000);
+    ts.tv_nsec = (long)(nanoTargetTime % 1000000000);
+    
+    // Restart the sleep if a signal handler has interrupted it
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+}
+
+#endif
+
 i64
-sleepUntil(u64 kernelTargetTime, u64 kernelEarlyWakeup)
+sleepUntil(u64 nanoTargetTime, u64 nanoEarlyWakeup)
 {
-    u64 now = mach_absolute_time();
+    u64 now = monotonicNanos();
     i64 jitter;
     
-    if (now > kernelTargetTime)
+    if (now > nanoTargetTime)
         return 0;
     
     // Sleep
-    // printf("Sleeping for %d\n", kernelTargetTime - now);
-    mach_wait_until(kernelTargetTime - kernelEarlyWakeup);
+    if (nanoTargetTime - now > nanoEarlyWakeup)
+        sleepUntilNanos(nanoTargetTime - nanoEarlyWakeup);
     
     // Count some sheep to increase precision
-    unsigned sheep = 0;
     do {
-        jitter = mach_absolute_time() - kernelTargetTime;
-        sheep++;
+        jitter = (i64)(monotonicNanos() - nanoTargetTime);
     } while (jitter < 0);
     
     return jitter;
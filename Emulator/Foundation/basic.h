@@ -21,8 +21,6 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 #include <time.h>
-#include <mach/mach.h>
-#include <mach/mach_time.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <errno.h>
@@ -31,10 +29,19 @@
 #include <math.h>
 #include <ctype.h> 
 
+#ifdef __MACH__
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#endif
+
 #include "C64Config.h"
 #include "C64Types.h"
 #include "C64Constants.h"
 
+//! @brief    Branch prediction hints (same definition as in reSID)
+#define likely(x)      __builtin_expect(!!(x), 1)
+#define unlikely(x)    __builtin_expect(!!(x), 0)
+
 //! @brief    Two bit binary value
 typedef u8 uint2_t;
 
@@ -333,14 +340,22 @@ u8 localTimeHour();
 //! @brief    Put the current thread to sleep for a certain amount of time.
 void sleepMicrosec(unsigned usec);
 
-/*! @brief    Sleeps until kernel timer reaches kernelTargetTime
- *  @param    kernelEarlyWakeup: To increase timing precision, the function
+/*! @brief    Reads the monotonic system clock.
+ *  @details  On macOS, the value is derived from mach_absolute_time(). On all
+ *            other POSIX systems, clock_gettime(CLOCK_MONOTONIC) is used.
+ *  @return   Elapsed time in nanoseconds since an unspecified starting point.
+ */
+u64 monotonicNanos();
+
+/*! @brief    Sleeps until the monotonic clock reaches nanoTargetTime
+ *  @param    nanoEarlyWakeup: To increase timing precision, the function
  *            wakes up the thread earlier by this amount and waits actively in
  *            a delay loop until the deadline is reached.
- *  @return   Overshoot time (jitter), measured in kernel time. Smaller values
+ *  @return   Overshoot time (jitter), measured in nanoseconds. Smaller values
  *            are better, 0 is best.
+ *  @see      monotonicNanos()
  */
-i64 sleepUntil(u64 kernelTargetTime, u64 kernelEarlyWakeup);
+i64 sleepUntil(u64 nanoTargetTime, u64 nanoEarlyWakeup);
 
 
 //
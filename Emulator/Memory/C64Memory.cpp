@@ -9,11 +9,18 @@
 
 #include "C64.h"
 
+//! @brief    Start addresses of the Basic, Character, and Kernal ROM
+static const u16 romStart[3] = { 0xA000, 0xD000, 0xE000 };
+
+//! @brief    Sizes of the Basic, Character, and Kernal ROM
+static const u16 romSize[3] = { 0x2000, 0x1000, 0x2000 };
+
 C64Memory::C64Memory(C64 &ref) : Memory(ref)
 {	
 	setDescription("C64 memory");
     		
     memset(rom, 0, sizeof(rom));
+    memset(romRef, 0, sizeof(romRef));
     stack = &ram[0x0100];
     
     // Register snapshot items
@@ -21,9 +28,7 @@ C64Memory::C64Memory(C64 &ref) : Memory(ref)
 
         { ram,             sizeof(ram),            KEEP_ON_RESET },
         { colorRam,        sizeof(colorRam),       KEEP_ON_RESET },
-        { &rom[0xA000],    0x2000,                 KEEP_ON_RESET }, /* Basic ROM */
-        { &rom[0xD000],    0x1000,                 KEEP_ON_RESET }, /* Character ROM */
-        { &rom[0xE000],    0x2000,                 KEEP_ON_RESET }, /* Kernal ROM */
+        { romRef,          sizeof(romRef),         KEEP_ON_RESET | QWORD_ARRAY },
         { &ramInitPattern, sizeof(ramInitPattern), KEEP_ON_RESET },
         { &peekSrc,        sizeof(peekSrc),        KEEP_ON_RESET },
         { &pokeTarget,     sizeof(pokeTarget),     KEEP_ON_RESET },
@@ -153,6 +158,45 @@ C64Memory::dump()
     */
 }
 
+void
+C64Memory::willSaveToBuffer(u8 **buffer)
+{
+    bool loaded[3] = { basicRomIsLoaded(), characterRomIsLoaded(), kernalRomIsLoaded() };
+    
+    // Replace the ROM images by their fingerprints
+    for (unsigned i = 0; i < 3; i++) {
+        
+        if (loaded[i]) {
+            romRef[i] = BlobStore::refresh(romBlob[i], rom + romStart[i], romSize[i]);
+        } else {
+            romRef[i] = 0;
+            romBlob[i].reset();
+        }
+    }
+}
+
+void
+C64Memory::didLoadFromBuffer(u8 **buffer)
+{
+    // Fetch the referenced ROM images (fails the load if one is missing)
+    for (unsigned i = 0; i < 3; i++) {
+        
+        if (romRef[i] == 0) {
+            memset(rom + romStart[i], 0, romSize[i]);
+            romBlob[i].reset();
+            continue;
+        }
+        c64->restoreBlob(romRef[i], romBlob[i], rom + romStart[i], romSize[i]);
+    }
+}
+
+void
+C64Memory::collectBlobs(BlobList &blobs)
+{
+    for (unsigned i = 0; i < 3; i++)
+        if (romBlob[i]) blobs.push_back(romBlob[i]);
+}
+
 void
 C64Memory::eraseWithPattern(RamInitPattern pattern)
 {
@@ -181,6 +225,9 @@ C64Memory::updatePeekPokeLookupTables()
     u8 exrom = c64->expansionport.getExromLine() ? 0x10 : 0x00;
     u8 index = (c64->processorPort.read() & 0x07) | exrom | game;
 
+    // A changed memory layout can break an idle loop
+    c64->cpu.leaveIdleLoop();
+    
     // Set ultimax flag
     c64->setUltimax(exrom && !game);
 
@@ -205,22 +252,27 @@ C64Memory::peek(u16 addr, MemoryType source)
         return rom[addr];
         
         case M_IO:
+        sideEffects++;
         return peekIO(addr);
         
         case M_CRTLO:
         case M_CRTHI:
+        sideEffects++;
         return c64->expansionport.peek(addr);
         
         case M_PP:
         if (likely(addr >= 0x02)) {
             return ram[addr];
-        } else if (addr == 0x00) {
+        }
+        sideEffects++;
+        if (addr == 0x00) {
             return c64->processorPort.readDirection();
         } else {
             return c64->processorPort.read();
         }
         
         case M_NONE:
+        sideEffects++;
         return c64->vic.getDataBusPhi1();
         
         default:
@@ -239,18 +291,6 @@ C64Memory::peek(u16 addr, bool gameLine, bool exromLine)
     return peek(addr, bankMap[index][addr >> 12]);
 }
 
-u8
-C64Memory::peekZP(u8 addr)
-{
-    if (likely(addr >= 0x02)) {
-        return ram[addr];
-    } else if (addr == 0x00) {
-        return c64->processorPort.readDirection();
-    } else {
-        return c64->processorPort.read();
-    }
-}
-
 u8
 C64Memory::peekIO(u16 addr)
 {
@@ -394,18 +434,23 @@ C64Memory::poke(u16 addr, u8 value, MemoryType target)
             return;
             
         case M_IO:
+            sideEffects++;
             pokeIO(addr, value);
             return;
             
         case M_CRTLO:
         case M_CRTHI:
+            sideEffects++;
             c64->expansionport.poke(addr, value);
             return;
             
         case M_PP:
             if (likely(addr >= 0x02)) {
                 ram[addr] = value;
-            } else if (addr == 0x00) {
+                return;
+            }
+            sideEffects++;
+            if (addr == 0x00) {
                 c64->processorPort.writeDirection(value);
             } else {
                 c64->processorPort.write(value);
@@ -431,18 +476,6 @@ C64Memory::poke(u16 addr, u8 value, bool gameLine, bool exromLine)
     poke(addr, value, bankMap[index][addr >> 12]);
 }
 
-void
-C64Memory::pokeZP(u8 addr, u8 value)
-{
-    if (likely(addr >= 0x02)) {
-        ram[addr] = value;
-    } else if (addr == 0x00) {
-        c64->processorPort.writeDirection(value);
-    } else {
-        c64->processorPort.write(value);
-    }
-}
-
 void
 C64Memory::pokeIO(u16 addr, u8 value)
 {
@@ -19,7 +19,7 @@
  *            processor port (memory address 1) and the current values of the
  *            Exrom and Game line.
  */
-class C64Memory : public Memory {
+class C64Memory final : public Memory {
 
 public:
     
@@ -88,6 +88,16 @@ public:
      */
     u8 rom[65536];
     
+    /*! @brief    Fingerprints of the Basic, Character, and Kernal ROM
+     *  @details  Snapshots only contain these fingerprints. The ROM images
+     *            are kept in the blob store. A value of 0 indicates that the
+     *            ROM is not installed.
+     */
+    u64 romRef[3];
+    
+    //! @brief    Blobs holding the ROM images referenced in the last snapshot
+    BlobRef romBlob[3];
+    
     //! @brief    RAM init pattern type
     RamInitPattern ramInitPattern;
     
@@ -99,6 +109,15 @@ public:
     
 public:
     
+    /*! @brief    Number of accesses that may have side effects
+     *  @details  Counts all accesses that are not handled by the RAM and ROM
+     *            fast paths. The CPU uses this value to recognize loops that
+     *            can be skipped.
+     *  @seealso  CPU::executeC64Cycle()
+     */
+    u64 sideEffects = 0;
+    
+    
 	//! @brief    Constructor
 	C64Memory(C64 &ref);
 	
@@ -114,6 +133,11 @@ public:
 	//! @brief    Method from HardwareComponent
 	void dump();
 
+    //! @brief    Methods from HardwareComponent
+    void willSaveToBuffer(u8 **buffer);
+    void didLoadFromBuffer(u8 **buffer);
+    void collectBlobs(BlobList &blobs);
+
 	//! @brief    Returns true, iff the Basic ROM has been loaded
 	bool basicRomIsLoaded() { return (rom[0xA000] | rom[0xA001]) != 0x00; }
     
@@ -173,23 +197,40 @@ public:
     //! @brief    Returns the current poke target of the specified memory address
     MemoryType getPokeTarget(u16 addr) { return pokeTarget[addr >> 12]; }
 
-    // Reading from memory
+    /* Reading from memory
+     *
+     * The single-argument versions are called by the CPU in each cycle.
+     * They handle RAM and ROM accesses inline and delegate everything else.
+     */
     u8 peek(u16 addr, MemoryType source);
     u8 peek(u16 addr, bool gameLine, bool exromLine);
-    u8 peek(u16 addr) { return peek(addr, peekSrc[addr >> 12]); }
-    u8 peekZP(u8 addr);
+    u8 peek(u16 addr) {
+        MemoryType source = peekSrc[addr >> 12];
+        if (source == M_RAM) return ram[addr];
+        if (source == M_ROM) return rom[addr];
+        return peek(addr, source); }
+    u8 peekZP(u8 addr) {
+        return addr >= 0x02 ? ram[addr] : peek(addr, M_PP); }
     u8 peekIO(u16 addr);
     
-    // Reading from memory without side effects
+    // Reading from memory without side effects (RAM and ROM inline)
     u8 spypeek(u16 addr, MemoryType source);
-    u8 spypeek(u16 addr) { return spypeek(addr, peekSrc[addr >> 12]); }
+    u8 spypeek(u16 addr) {
+        MemoryType source = peekSrc[addr >> 12];
+        if (source == M_RAM) return ram[addr];
+        if (source == M_ROM) return rom[addr];
+        return spypeek(addr, source); }
     u8 spypeekIO(u16 addr);
     
     // Writing into memory
     void poke(u16 addr, u8 value, MemoryType target);
     void poke(u16 addr, u8 value, bool gameLine, bool exromLine);
-    void poke(u16 addr, u8 value) { poke(addr, value, pokeTarget[addr >> 12]); }
-    void pokeZP(u8 addr, u8 value);
+    void poke(u16 addr, u8 value) {
+        MemoryType target = pokeTarget[addr >> 12];
+        if (target == M_RAM || target == M_ROM) ram[addr] = value;
+        else poke(addr, value, target); }
+    void pokeZP(u8 addr, u8 value) {
+        if (addr >= 0x02) ram[addr] = value; else poke(addr, value, M_PP); }
     void pokeIO(u16 addr, u8 value);
     
     //! @brief    Reads the NMI vector from memory.
@@ -11,6 +11,7 @@
 #define _MEMORY_INC
 
 #include "C64Component.h"
+#include "Breakpoints.h"
 // #include "MemoryTypes.h"
 
 
@@ -18,6 +19,7 @@
 class Memory : public C64Component {
 
     friend class CPU;
+    template <class M> friend class Watched;
     
 protected:
     
@@ -28,6 +30,12 @@ protected:
     
 public:
     
+    /*! @brief    Watchpoints of the connected CPU
+     *  @details  NULL unless a watchpoint is set. While this pointer is set,
+     *            the CPU accesses the memory through Watched<M>.
+     */
+    Breakpoints *guards = NULL;
+    
     Memory(C64 &ref) : C64Component(ref) { };
     
 private:
@@ -64,4 +72,59 @@ public:
     virtual void pokeStack(u8 sp, u8 value) { stack[sp] = value; }
 };
 
+
+/*! @brief    Memory of type M as seen by a watched CPU
+ *  @details  Reports each access to the watchpoints before passing it on to
+ *            the memory. The CPU core is instantiated for Watched<M> and
+ *            only runs this instantiation while a watchpoint is set. Hence,
+ *            the accesses of an unwatched CPU cost nothing extra.
+ *  @see      CPU::executeCycle()
+ */
+template <class M> class Watched {
+    
+    //! @brief    The watched memory
+    M *mem;
+    
+public:
+    
+    Watched(M *mem) : mem(mem) { }
+    
+    //! @brief    Lets a Watched<M> be used like a pointer to M.
+    Watched *operator->() { return this; }
+    
+    u8 peek(u16 addr) {
+        mem->guards->checkWatchpoint(addr, WATCH_READ);
+        return mem->peek(addr); }
+    u8 peekZP(u8 addr) {
+        mem->guards->checkWatchpoint(addr, WATCH_READ);
+        return mem->peekZP(addr); }
+    u8 peekStack(u8 sp) {
+        mem->guards->checkWatchpoint(0x100 | sp, WATCH_READ);
+        return mem->peekStack(sp); }
+    u8 spypeek(u16 addr) { return mem->spypeek(addr); }
+    
+    void poke(u16 addr, u8 value) {
+        mem->guards->checkWatchpoint(addr, WATCH_WRITE);
+        mem->poke(addr, value); }
+    void pokeZP(u8 addr, u8 value) {
+        mem->guards->checkWatchpoint(addr, WATCH_WRITE);
+        mem->pokeZP(addr, value); }
+    void pokeStack(u8 sp, u8 value) {
+        mem->guards->checkWatchpoint(0x100 | sp, WATCH_WRITE);
+        mem->pokeStack(sp, value); }
+};
+
+/*! @brief    Binds the memory of a CPU to the memory type of an instantiation
+ *  @details  Yields a plain pointer to M, or a Watched<M> for watched CPUs.
+ */
+template <class M> struct MemoryView {
+    typedef M *Type;
+    static Type bind(Memory *mem) { return static_cast<M *>(mem); }
+};
+
+template <class M> struct MemoryView<Watched<M>> {
+    typedef Watched<M> Type;
+    static Type bind(Memory *mem) { return Watched<M>(static_cast<M *>(mem)); }
+};
+
 #endif
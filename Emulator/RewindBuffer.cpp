@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "RewindBuffer.h"
+#include <algorithm>
+
+RewindBuffer::~RewindBuffer()
+{
+    clear();
+}
+
+void
+RewindBuffer::setBudget(size_t bytes)
+{
+    budget = bytes;
+    while (entries.size() > 1 && usage > budget) erase(0);
+}
+
+Snapshot *
+RewindBuffer::get(size_t nr)
+{
+    return nr < entries.size() ? entries[entries.size() - 1 - nr].snapshot : NULL;
+}
+
+u64
+RewindBuffer::getFrame(size_t nr)
+{
+    return nr < entries.size() ? entries[entries.size() - 1 - nr].frame : 0;
+}
+
+Snapshot *
+RewindBuffer::find(u64 frame, u64 *snapshotFrame)
+{
+    // Binary search for the first entry taken after the specified frame
+    auto it = std::upper_bound(entries.begin(), entries.end(), frame,
+                               [](u64 f, const Entry &e) { return f < e.frame; });
+    if (it == entries.begin()) return NULL;
+
+    --it;
+    if (snapshotFrame) *snapshotFrame = it->frame;
+    return it->snapshot;
+}
+
+void
+RewindBuffer::record(u64 frame, Snapshot *snapshot)
+{
+    assert(snapshot != NULL);
+
+    // Discard the snapshots of an abandoned timeline
+    while (!entries.empty() && entries.back().frame >= frame) {
+        erase(entries.size() - 1);
+    }
+
+    Entry entry = { frame, snapshot, snapshot->getKeyframe(), snapshot->footprint(), 0 };
+
+    // A keyframe is charged to the oldest snapshot referring to it
+    if (entry.keyframe && (entries.empty() || entries.back().keyframe != entry.keyframe)) {
+        entry.keyframeBytes = entry.keyframe->footprint();
+    }
+    entries.push_back(entry);
+    usage += entry.bytes + entry.keyframeBytes;
+
+    // Delete old snapshots until the budget is met
+    while (entries.size() > 1 && usage > budget) erase(0);
+}
+
+void
+RewindBuffer::remove(size_t nr)
+{
+    if (nr < entries.size()) erase(entries.size() - 1 - nr);
+}
+
+void
+RewindBuffer::clear()
+{
+    for (auto &entry : entries) delete entry.snapshot;
+    entries.clear();
+    usage = 0;
+}
+
+void
+RewindBuffer::erase(size_t i)
+{
+    assert(i < entries.size());
+
+    Entry &entry = entries[i];
+    assert(usage >= entry.bytes + entry.keyframeBytes);
+    usage -= entry.bytes + entry.keyframeBytes;
+
+    // Hand over the keyframe charge to the successor
+    if (entry.keyframeBytes && i + 1 < entries.size()) {
+        
+        Entry &next = entries[i + 1];
+        if (next.keyframe == entry.keyframe && !next.keyframeBytes) {
+            next.keyframeBytes = entry.keyframeBytes;
+            usage += next.keyframeBytes;
+        }
+    }
+
+    delete entry.snapshot;
+    entries.erase(entries.begin() + i);
+}
@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _REWINDBUFFER_INC
+#define _REWINDBUFFER_INC
+
+#include "Snapshot.h"
+#include <deque>
+
+/*! @brief    A time-indexed ring of snapshots
+ *  @details  Snapshots are stored in chronological order together with the
+ *            frame number they were taken at. New snapshots are appended at
+ *            the end and the oldest ones are dropped from the front as soon
+ *            as the memory budget is exceeded. Delta snapshots are accounted
+ *            for together with their keyframes. The charged amounts are
+ *            fixed when a snapshot is recorded, so that the usage stays
+ *            consistent even if a stored snapshot changes its footprint
+ *            later on.
+ */
+class RewindBuffer {
+
+    //! @brief    A single snapshot together with its position in time
+    struct Entry {
+
+        u64 frame;
+        Snapshot *snapshot;
+
+        //! @brief    Keyframe of the snapshot when it was recorded (or NULL)
+        Snapshot *keyframe;
+
+        //! @brief    Bytes charged for the snapshot itself
+        size_t bytes;
+
+        /*! @brief    Bytes charged for the keyframe
+         *  @details  A keyframe is charged to the oldest entry referring to
+         *            it. For all other entries, this value is 0.
+         */
+        size_t keyframeBytes;
+    };
+
+    //! @brief    Stored snapshots, oldest first
+    std::deque<Entry> entries;
+
+    //! @brief    Maximum number of bytes occupied by all stored snapshots
+    size_t budget = 16 * 1024 * 1024;
+
+    //! @brief    Number of bytes occupied by all stored snapshots
+    size_t usage = 0;
+
+public:
+
+    //! @brief    Destructor
+    ~RewindBuffer();
+
+    //! @brief    Returns the memory budget in bytes
+    size_t getBudget() { return budget; }
+
+    /*! @brief    Sets the memory budget in bytes
+     *  @details  The latest snapshot is always kept, even if it exceeds the
+     *            budget on its own.
+     */
+    void setBudget(size_t bytes);
+
+    //! @brief    Returns the number of bytes occupied by all stored snapshots
+    size_t getUsage() { return usage; }
+
+    //! @brief    Returns the number of stored snapshots
+    size_t count() { return entries.size(); }
+
+    //! @brief    Returns a snapshot (0 = latest) or NULL
+    Snapshot *get(size_t nr);
+
+    //! @brief    Returns the frame a snapshot was taken at (0 = latest)
+    u64 getFrame(size_t nr);
+
+    /*! @brief    Returns the latest snapshot taken at or before a frame
+     *  @return   NULL if no such snapshot exists.
+     */
+    Snapshot *find(u64 frame, u64 *snapshotFrame = NULL);
+
+    /*! @brief    Adds a snapshot taken at the specified frame
+     *  @details  The buffer takes ownership of the snapshot. All snapshots
+     *            taken at the same frame or later are discarded first. They
+     *            belong to a timeline that has been left by rewinding or
+     *            resetting the emulator.
+     */
+    void record(u64 frame, Snapshot *snapshot);
+
+    //! @brief    Deletes a snapshot (0 = latest)
+    void remove(size_t nr);
+
+    //! @brief    Deletes all snapshots
+    void clear();
+
+private:
+
+    /*! @brief    Deletes entries[i] and updates the memory usage
+     *  @details  A keyframe charge is handed over to the next entry if that
+     *            entry refers to the same keyframe.
+     */
+    void erase(size_t i);
+};
+
+#endif
@@ -242,7 +242,7 @@ public:
     void handleBufferOverflow();
     
     //! @brief   Signals to ignore the next underflow or overflow condition.
-    void ignoreNextUnderOrOverflow() { lastAlignment = mach_absolute_time(); }
+    void ignoreNextUnderOrOverflow() { lastAlignment = monotonicNanos(); }
         
     //! @brief   Moves read pointer one position forward
     void advanceReadPtr() { readPtr = (readPtr + 1) % bufferSize; }
@@ -24,7 +24,27 @@ VIC::VIC(C64 &ref) : C64Component(ref)
     
 	markIRQLines = false;
 	markDMALines = false;
+    skippedFrames = 0;
+    skipPeriod = 1;
+    
+    // The buffer indices are never reset, because the consumer may hold a
+    // buffer while the emulator is resetting.
+    writeBuffer = 0;
+    readBuffer = 1;
+    latestBuffer = 2;
+    stableBuffer = 2;
+    frameSeqNr = 1;
+    readSeqNr = 0;
+    currentScreenBuffer = indexBuffers[writeBuffer];
+    screenFormat = SCREEN_RGBA;
     emulateGrayDotBug = true;
+    
+    // The render thread is started on request
+    renderLog = NULL;
+    renderPending = false;
+    pthread_mutex_init(&renderLock, NULL);
+    pthread_cond_init(&renderWork, NULL);
+    pthread_cond_init(&renderDone, NULL);
     palette = COLOR_PALETTE;
     
     // Register snapshot items
@@ -104,6 +124,16 @@ VIC::VIC(C64 &ref) : C64Component(ref)
 
 VIC::~VIC()
 {
+    if (renderLog) stopRenderThread();
+    
+    for (unsigned i = 0; i < 3; i++) {
+        delete[] screenBuffers[i];
+        delete[] indexBuffers[i];
+    }
+    
+    pthread_cond_destroy(&renderDone);
+    pthread_cond_destroy(&renderWork);
+    pthread_mutex_destroy(&renderLock);
 }
 
 void
@@ -119,6 +149,7 @@ VIC::setC64(C64 *c64)
 void 
 VIC::reset()
 {
+    if (renderPending) waitForRenderer();
     HardwareComponent::reset();
     
     yCounter = PAL_HEIGHT;
@@ -155,8 +186,12 @@ VIC::reset()
 	spriteBackgroundCollisionEnabled = 0xFF;
     
     // Screen buffer
-    currentScreenBuffer = screenBuffer1;
     pixelBuffer = currentScreenBuffer;
+    drawFrame = true;
+    lazyCanvas = false;
+    canvasOmitted = false;
+    quietLine = false;
+    numQuietCycles = 0;
 }
 
 void
@@ -237,11 +272,26 @@ VIC::stateSize()
     + gAccessResult.stateSize();
 }
 
+void
+VIC::willLoadFromBuffer(u8 **buffer)
+{
+    if (renderPending) waitForRenderer();
+}
+
 void
 VIC::didLoadFromBuffer(u8 **buffer)
 {
     baLine.loadFromBuffer(buffer);
     gAccessResult.loadFromBuffer(buffer);
+    quietLine = false;
+    numQuietCycles = 0;
+}
+
+void
+VIC::willSaveToBuffer(u8 **buffer)
+{
+    if (renderPending) waitForRenderer();
+    leaveQuietLine();
 }
 
 void
@@ -392,11 +442,49 @@ VIC::isVBlankLine(unsigned rasterline)
 
 void *
 VIC::screenBuffer() {
-    if (currentScreenBuffer == screenBuffer1) {
-        return screenBuffer2;
-    } else {
-        return screenBuffer1;
+    
+    u64 latest = __atomic_load_n(&latestBuffer, __ATOMIC_RELAXED);
+    
+    // Swap buffers if a new frame has been completed
+    while (latest & 4) {
+        
+        // Leave the sequence number intact and hand back the old buffer
+        u64 handback = (latest & ~7ULL) | readBuffer;
+        if (__atomic_compare_exchange_n(&latestBuffer, &latest, handback, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            readBuffer = latest & 3;
+            readSeqNr = latest >> 3;
+            break;
+        }
+    }
+    
+    if (screenFormat == SCREEN_INDEXED) {
+        return indexBuffers[readBuffer];
+    }
+    return screenBuffers[readBuffer];
+}
+
+void
+VIC::setScreenFormat(ScreenFormat format)
+{
+    if (!isScreenFormat(format)) {
+        warn("Invalid screen format (%d)\n", format);
+        return;
+    }
+    
+    screenFormat = format;
+}
+
+void
+VIC::setFrameSkip(unsigned skipped, unsigned period)
+{
+    if (skipped >= period) {
+        warn("Invalid frame skip setting (%d out of %d)\n", skipped, period);
+        return;
     }
+    
+    skippedFrames = skipped;
+    skipPeriod = period;
 }
 
 void
@@ -404,9 +492,14 @@ VIC::resetScreenBuffers()
 {
     for (unsigned line = 0; line < PAL_RASTERLINES; line++) {
         for (unsigned i = 0; i < NTSC_PIXELS; i++) {
-            screenBuffer1[line * NTSC_PIXELS + i] =
-            screenBuffer2[line * NTSC_PIXELS + i] =
+            screenBuffers[0][line * NTSC_PIXELS + i] =
+            screenBuffers[1][line * NTSC_PIXELS + i] =
+            screenBuffers[2][line * NTSC_PIXELS + i] =
             (line % 2) ? rgbaTable[8] : rgbaTable[9];
+            indexBuffers[0][line * NTSC_PIXELS + i] =
+            indexBuffers[1][line * NTSC_PIXELS + i] =
+            indexBuffers[2][line * NTSC_PIXELS + i] =
+            (line % 2) ? 8 : 9;
         }
     }
 }
@@ -645,15 +738,6 @@ VIC::checkForLightpenIrqAtStartOfFrame()
 // Sprites
 //
 
-u8
-VIC::spriteDepth(u8 nr)
-{
-    return
-    GET_BIT(reg.delayed.sprPriority, nr) ?
-    (SPRITE_LAYER_BG_DEPTH | nr) :
-    (SPRITE_LAYER_FG_DEPTH | nr);
-}
-
 u8
 VIC::compareSpriteY()
 {
@@ -767,10 +851,24 @@ VIC::beginFrame()
 void
 VIC::endFrame()
 {
-    // Switch active screen buffer
-    bool first = (currentScreenBuffer == screenBuffer1);
-    currentScreenBuffer = first ? screenBuffer2 : screenBuffer1;
-    pixelBuffer = currentScreenBuffer;
+    // Hand over the screen buffer if a frame has been drawn
+    if (drawFrame) {
+        if (renderPending) waitForRenderer();
+        if (screenFormat == SCREEN_RGBA) {
+            convertToRGBA(indexBuffers[writeBuffer], (u32 *)screenBuffers[writeBuffer],
+                          PAL_RASTERLINES * NTSC_PIXELS);
+        }
+        u64 published = (frameSeqNr++ << 3) | 4 | writeBuffer;
+        stableBuffer = writeBuffer;
+        writeBuffer = __atomic_exchange_n(&latestBuffer, published, __ATOMIC_ACQ_REL) & 3;
+        currentScreenBuffer = indexBuffers[writeBuffer];
+    }
+    
+    // Decide whether the next frame is drawn or skipped
+    u64 frame = c64->frame;
+    drawFrame = (frame % skipPeriod) >= skippedFrames;
+    lazyCanvas = !drawFrame && ((frame + 1) % skipPeriod) < skippedFrames;
+    pixelBuffer = drawFrame ? currentScreenBuffer : scratchLine;
 }
 
 void 
@@ -801,11 +899,25 @@ VIC::beginRasterline(u16 line)
     } else {
         bufferoffset = NTSC_LEFT_BORDER_WIDTH - 32;
     }
+    
+    // Defer drawing if no register used for drawing is about to change
+    quietLine = drawingRegistersSettled();
+    numQuietCycles = 0;
 }
 
 void 
 VIC::endRasterline()
 {
+    // Draw the deferred part of the rasterline or let the render thread do it
+    bool logged =
+    quietLine && renderLog && drawFrame && !vblank && !markIRQLines && !markDMALines;
+    
+    if (logged) {
+        logQuietLine();
+    } else {
+        leaveQuietLine();
+    }
+    
     // Set vertical flipflop if condition was hit
     // Do we need to do this here? It is handled in cycle 1 as well.
     if (verticalFrameFFsetCond) {
@@ -818,10 +930,10 @@ VIC::endRasterline()
     if (markDMALines && badLine)
         markLine(VICII_RED);
     
-    if (!vblank) {
+    if (!vblank && drawFrame) {
         
         // Make the border look nice (evetually, we should get rid of this)
-        expandBorders();
+        if (!logged) expandBorders(pixelBuffer, isPAL());
 
         //
         // Experimental code for RF modulator effect
@@ -24,14 +24,6 @@
 #define SPR6 0x40
 #define SPR7 0x80
 
-// Depth of different drawing layers
-#define BORDER_LAYER_DEPTH 0x10         // In front of everything
-#define SPRITE_LAYER_FG_DEPTH 0x20      // Behind border
-#define FOREGROUND_LAYER_DEPTH 0x30     // Behind sprite 1 layer
-#define SPRITE_LAYER_BG_DEPTH 0x40      // Behind foreground
-#define BACKGROUD_LAYER_DEPTH 0x50      // Behind sprite 2 layer
-#define BEHIND_BACKGROUND_DEPTH 0x60    // Behind background
-
 // Event flags
 #define VICUpdateIrqLine    (1ULL << 0) // Sets or releases the IRQ line
 #define VICLpTransition     (1ULL << 1) // Triggers a lightpen event
@@ -591,6 +583,134 @@ private:
     double saturation = 50.0;
 
     
+    //
+    // Frame skipping
+    //
+    
+    //! @brief    Number of frames that are skipped in each period
+    unsigned skippedFrames;
+    
+    //! @brief    Length of a frame skipping period in frames
+    unsigned skipPeriod;
+    
+    /*! @brief    Indicates if the current frame is written into the screen buffer
+     *  @details  If false, the frame is skipped. All bus visible actions are
+     *            still carried out, but pixels end up in scratchLine.
+     */
+    bool drawFrame;
+    
+    /*! @brief    Indicates if canvas pixels are synthesized on demand, only
+     *  @details  If true, the canvas and the border are only drawn in cycles
+     *            where a sprite might be drawn, too. Pixels are needed in these
+     *            cycles to detect sprite-background collisions. This mode is
+     *            enabled for all skipped frames except the one preceding a
+     *            drawn frame.
+     */
+    bool lazyCanvas;
+    
+    //! @brief    Indicates that drawing has been omitted since the last draw
+    bool canvasOmitted;
+    
+    /*! @brief    Drawing inputs of a single cycle on a quiet rasterline
+     *  @details  Everything the canvas and border logic reads in a drawing
+     *            cycle, except for the registers, which stay unchanged on
+     *            a quiet rasterline.
+     */
+    struct QuietCycle {
+        
+        //! @brief    Value of gAccessResult.delayed()
+        u32 gAccess;
+        
+        //! @brief    Position of the first pixel in pixelBuffer
+        short bufferoffset;
+        
+        //! @brief    Draw routine (0 = draw(), 17 = draw17(), 55 = draw55())
+        u8 variant;
+        
+        //! @brief    Values of sr.canLoad and the frame flipflops
+        bool canLoad;
+        bool vertical;
+        bool mainDelayed;
+        bool mainCurrent;
+    };
+    
+    /*! @brief    Indicates that drawing is deferred to the end of the rasterline
+     *  @details  A rasterline is quiet if the drawing registers are settled
+     *            when it begins. Drawing cycles then only record their inputs.
+     *            The recorded cycles are drawn in one go by drawQuietLine().
+     *            This happens at the end of the rasterline or as soon as the
+     *            line stops being quiet, i.e., when a VIC register is written
+     *            or a sprite needs to be drawn. Memory writes, bank switches
+     *            and BA transitions do not matter, because they only affect
+     *            fetches whose results are recorded.
+     */
+    bool quietLine;
+    
+    //! @brief    Recorded cycles of the current quiet rasterline
+    QuietCycle quietCycles[64];
+    
+    //! @brief    Number of recorded cycles
+    u8 numQuietCycles;
+    
+    
+    //
+    // Render thread
+    //
+    
+    //! @brief    A quiet rasterline handed over to the render thread
+    struct RenderRecord {
+        
+        //! @brief    First pixel of the rasterline in the screen buffer
+        u8 *pixels;
+        
+        //! @brief    Drawing registers of the rasterline
+        u8 ctrl1;
+        u8 ctrl2;
+        u8 colors[COLREG_BG3 + 1];
+        
+        //! @brief    Indicates if the borders are expanded for a PAL screen
+        bool pal;
+        
+        //! @brief    Recorded cycles
+        u8 numCycles;
+        QuietCycle cycles[64];
+    };
+    
+    //! @brief    Number of records in the render log
+    static const unsigned renderLogSize = 512;
+    
+    /*! @brief    Ring of rasterlines waiting to be drawn by the render thread
+     *  @details  NULL if no render thread is running. The emulator thread
+     *            appends records at renderHead, the render thread draws them
+     *            up to renderTail. Both counters are guarded by renderLock.
+     *            The render thread takes all pending records at once and only
+     *            locks again when it is done with them.
+     */
+    RenderRecord *renderLog;
+    u64 renderHead;
+    u64 renderTail;
+    
+    /*! @brief    Indicates that the render thread owns the canvas state
+     *  @details  While records are pending, the render thread advances the
+     *            graphics shift register (sr) and the color table (col). The
+     *            emulator thread must call waitForRenderer() before it touches
+     *            them itself. Only accessed by the emulator thread.
+     */
+    bool renderPending;
+    
+    //! @brief    Asks the render thread to terminate
+    bool renderStop;
+    
+    pthread_t renderThread;
+    pthread_mutex_t renderLock;
+    
+    //! @brief    Signaled when records are appended or renderStop is set
+    pthread_cond_t renderWork;
+    
+    //! @brief    Signaled when the render thread has drawn all pending records
+    pthread_cond_t renderDone;
+    
+    
 	//
 	// Debugging and cheating
 	//
@@ -661,49 +781,98 @@ private:
      */
     u32 rgbaTable[16];
     
-    /*! @brief    First screen buffer
-     *  @details  The VIC chip writes its output into this buffer. The contents
-     *            of the array is later copied into to texture RAM of your
-     *            graphic card by the drawRect method in the GPU related code.
+    /*! @brief    Screen buffers
+     *  @details  The VIC chip uses triple buffering. At any time, one buffer
+     *            is written by the emulator thread, one buffer is held by the
+     *            consumer (e.g., the GPU code copying the contents into texture
+     *            RAM), and one buffer contains the latest complete frame. The
+     *            emulator never waits for the consumer. If the consumer is too
+     *            slow, frames are dropped.
+     */
+    int *screenBuffers[3] = {
+        new int[PAL_RASTERLINES * NTSC_PIXELS],
+        new int[PAL_RASTERLINES * NTSC_PIXELS],
+        new int[PAL_RASTERLINES * NTSC_PIXELS] };
+    
+    /*! @brief    Color index buffers
+     *  @details  The VIC chip draws one byte per pixel holding the color
+     *            number. Each index buffer belongs to the screen buffer with
+     *            the same index. In RGBA format, a completed frame is converted
+     *            into its screen buffer in a single pass. In indexed format,
+     *            the index buffers are handed out directly and the screen
+     *            buffers stay untouched.
      */
-    int *screenBuffer1 = new int[PAL_RASTERLINES * NTSC_PIXELS];
+    u8 *indexBuffers[3] = {
+        new u8[PAL_RASTERLINES * NTSC_PIXELS],
+        new u8[PAL_RASTERLINES * NTSC_PIXELS],
+        new u8[PAL_RASTERLINES * NTSC_PIXELS] };
+    
+    //! @brief    Pixel format of the frames handed out to the consumer
+    ScreenFormat screenFormat;
+    
+    //! @brief    Index of the screen buffer the VIC chip is drawing into
+    u8 writeBuffer;
+    
+    //! @brief    Index of the screen buffer held by the consumer
+    u8 readBuffer;
     
-    /*! @brief    Second screen buffer
-     *  @details  The VIC chip uses double buffering. Once a frame is drawn, the
-     *            VIC chip writes the next frame to the second buffer.
+    /*! @brief    Buffer exchange slot
+     *  @details  This variable is the only link between the emulator thread
+     *            and the consumer. Bits 0 and 1 hold the index of the spare
+     *            buffer. Bit 2 is set if the spare buffer contains a frame that
+     *            has not been picked up by the consumer yet. The remaining bits
+     *            hold the sequence number of the latest complete frame. Both
+     *            threads hand over buffers by atomically exchanging their own
+     *            buffer index with the one stored in here.
      */
-    int *screenBuffer2 = new int [PAL_RASTERLINES * NTSC_PIXELS];
+    u64 latestBuffer;
     
-    /*! @brief    Target screen buffer for all rendering methods
-     *  @details  The variable points either to screenBuffer1 or screenBuffer2
+    /*! @brief    Index of the screen buffer holding the latest complete frame
+     *  @details  This variable is only accessed by the emulator thread.
      */
-    int *currentScreenBuffer;
+    u8 stableBuffer;
+    
+    //! @brief    Sequence number of the frame being drawn
+    u64 frameSeqNr;
+    
+    //! @brief    Sequence number of the frame held by the consumer
+    u64 readSeqNr;
+    
+    /*! @brief    Target buffer for all rendering methods
+     *  @details  The variable points to indexBuffers[writeBuffer]
+     */
+    u8 *currentScreenBuffer;
     
     /*! @brief    Pointer to the beginning of the current rasterline
      *  @details  This pointer is used by all rendering methods to write pixels.
-     *            It always points to the beginning of a rasterline, either in
-     *            screenBuffer1 or screenBuffer2. It is reset at the beginning
-     *            of each frame and incremented at the beginning of each
-     *            rasterline.
+     *            It always points to the beginning of a rasterline in
+     *            currentScreenBuffer. It is reset at the beginning of each
+     *            frame and incremented at the beginning of each rasterline.
+     */
+    u8 *pixelBuffer;
+    
+    /*! @brief    Pixel sink for skipped frames
+     *  @details  While a frame is skipped, pixelBuffer points to this buffer.
+     *            Hence, all pixels of a skipped frame are written into the same
+     *            rasterline which stays in the cache and leaves both screen
+     *            buffers untouched.
      */
-    int *pixelBuffer;
+    u8 scratchLine[NTSC_PIXELS];
     
-    /*! @brief    Z buffer
-     *  @details  Depth buffering is used to determine pixel priority. In the
-     *            various render routines, a color value is only retained, if it
-     *            is closer to the view point. The depth of the closest pixel is
-     *            kept in the z buffer. The lower the value, the closer it is to
-     *            the viewer.
+    /*! @brief    Canvas pixels of the current cycle in the foreground layer
+     *  @details  Bit n refers to pixel n. Foreground pixels hide sprites with
+     *            the priority bit set and cause sprite-background collisions.
      */
-    u8 zBuffer[8];
+    u8 foregroundPixels;
     
-    /*! @brief    Indicates the source of a drawn pixel
-     *  @details  Whenever a foreground pixel or sprite pixel is drawn, a
-     *            distinct bit in the pixelSource array is set. The information
-     *            is needed to detect sprite-sprite and sprite-background
-     *            collisions.
+    /*! @brief    Canvas pixels of the current cycle in the background layer
+     *  @details  Bit n refers to pixel n. Sprites show up in front of these
+     *            pixels regardless of their priority bit. Pixels that are
+     *            neither in the foreground nor in the background layer are
+     *            covered by the border or haven't been drawn at all. Sprites
+     *            never show up there.
      */
-    u16 pixelSource[8];
+    u8 backgroundPixels;
     
     /*! @brief    Offset into pixelBuffer
      *  @details  Variable points to the first pixel of the currently drawn 8
@@ -736,6 +905,8 @@ public:
 	void dump();
     size_t stateSize();
     void didLoadFromBuffer(u8 **buffer);
+    void willLoadFromBuffer(u8 **buffer);
+    void willSaveToBuffer(u8 **buffer);
     void didSaveToBuffer(u8 **buffer);
     
 
@@ -773,6 +944,11 @@ public:
     //! @brief    Returns true if an older MOS 656x chip is plugged in.
     bool is656x() { return model & ~(PAL_8565 | NTSC_8562); }
 
+    //! @brief    Compile-time versions of the model checks above
+    static constexpr bool isPAL(VICModel m) { return m & (PAL_6569_R1 | PAL_6569_R3 | PAL_8565); }
+    static constexpr bool is856x(VICModel m) { return m & (PAL_8565 | NTSC_8562); }
+    static constexpr bool is656x(VICModel m) { return !is856x(m); }
+
     //! @brief    Returns true if the emulated chip has the gray dot bug.
     bool hasGrayDotBug() { return is856x(); }
 
@@ -818,12 +994,101 @@ public:
     //! @functiongroup Accessing the screen buffer and display properties
     //
     
-    //! @brief    Returns the currently stabel screen buffer.
+    /*! @brief    Returns the latest complete frame.
+     *  @details  The returned buffer is owned by the caller until the next
+     *            call to this function. It is never written by the emulator
+     *            thread in the meantime. If no new frame has been completed
+     *            since the last call, the same buffer is returned again. This
+     *            function is lock-free and meant to be called by a single
+     *            consumer thread. It must not be called by the emulator thread.
+     *            The pixel format is determined by getScreenFormat().
+     *  @seealso  stableScreenBuffer()
+     */
     void *screenBuffer();
 
-    //! @brief    Initializes both screenBuffers
+    //! @brief    Returns the sequence number of the frame handed out by screenBuffer()
+    u64 screenBufferSeqNr() { return readSeqNr; }
+    
+    /*! @brief    Returns the sequence number of the latest complete frame
+     *  @details  Consumers can poll this value to find out whether a new frame
+     *            is available without acquiring a buffer.
+     */
+    u64 latestSeqNr() { return __atomic_load_n(&latestBuffer, __ATOMIC_ACQUIRE) >> 3; }
+    
+    /*! @brief    Returns the latest complete frame to the emulator thread.
+     *  @details  Unlike screenBuffer(), this function does not take ownership
+     *            of the buffer. Hence, it must only be called from within the
+     *            emulator thread or while the emulator is suspended.
+     */
+    void *stableScreenBuffer() {
+        return screenFormat == SCREEN_INDEXED ?
+        (void *)indexBuffers[stableBuffer] : (void *)screenBuffers[stableBuffer]; }
+    
+    /*! @brief    Returns the color numbers of the latest complete frame.
+     *  @details  This buffer is valid in both formats. The same restrictions
+     *            as for stableScreenBuffer() apply.
+     */
+    u8 *stableIndexBuffer() { return indexBuffers[stableBuffer]; }
+    
+    /*! @brief    Selects the pixel format of the screen buffers
+     *  @details  In RGBA format, each pixel is a 32 bit color value taken from
+     *            the current palette. In indexed format, each pixel is a single
+     *            byte holding a color number between 0 and 15. Consumers
+     *            preferring indices save the conversion to RGBA. The new
+     *            setting takes effect with the next frame.
+     */
+    void setScreenFormat(ScreenFormat format);
+    
+    //! @brief    Returns the pixel format of the screen buffers
+    ScreenFormat getScreenFormat() { return screenFormat; }
+    
+    /*! @brief    Converts color numbers into RGBA values of the current palette
+     *  @details  Uses byte shuffles on 16 pixels at a time where available.
+     */
+    void convertToRGBA(const u8 *src, u32 *dst, size_t count);
+
+    /*! @brief    Configures frame skipping
+     *  @details  Out of each period of frames, the first skipped frames are
+     *            not drawn into the screen buffer. The stable screen buffer
+     *            keeps the last drawn frame in the meantime. Badlines, BA,
+     *            sprite DMA, collisions, and IRQs are emulated as usual. The
+     *            new setting takes effect with the next frame.
+     *  @param    skipped must be smaller than period. 0 disables frame skipping.
+     */
+    void setFrameSkip(unsigned skipped, unsigned period);
+    
+    //! @brief    Returns the number of skipped frames per period
+    unsigned getSkippedFrames() { return skippedFrames; }
+    
+    //! @brief    Returns the length of a frame skipping period
+    unsigned getSkipPeriod() { return skipPeriod; }
+    
+    //! @brief    Returns true if the current frame is drawn
+    bool isDrawingFrame() { return drawFrame; }
+    
+    /*! @brief    Starts or stops the render thread
+     *  @details  While the render thread is running, quiet rasterlines of
+     *            drawn frames are logged at the end of the line and drawn by
+     *            the render thread in the background. All other rasterlines
+     *            are still drawn by the emulator thread. The emulator state is
+     *            the same in both cases. A frame is handed out when the render
+     *            thread has finished it.
+     */
+    void setRenderThread(bool enable);
+    
+    //! @brief    Returns true if the render thread is running
+    bool hasRenderThread() { return renderLog != NULL; }
+    
+    /*! @brief    Main loop of the render thread
+     *  @details  Runs until the render thread is stopped. Never call this
+     *            function directly.
+     */
+    void renderLoop();
+    
+
+    //! @brief    Initializes all screenBuffers
     /*! @details  This function is needed for debugging, only. It write some
-     *            recognizable pattern into both buffers.
+     *            recognizable pattern into all buffers.
      */
     void resetScreenBuffers();
 
@@ -946,7 +1211,7 @@ private:
      *  @details  During a g-access, graphics data (character or bitmap
      *            patterns) is read.
      */
-    void gAccess();
+    template <VICModel model> void gAccess();
 
     //! @brief    Computes the g-access fetch address for newer VICIIs
     u16 gAccessAddr85x();
@@ -997,6 +1262,9 @@ private:
      *            in the middle of the lower border area.
      */
     bool yCounterOverflow() { return rasterline() == (isPAL() ? 0 : 238); }
+    template <VICModel model> bool yCounterOverflow() {
+        return rasterline() == (isPAL(model) ? 0 : 238);
+    }
 
 
     //
@@ -1175,11 +1443,6 @@ private:
 
 private:
 
-    /*! @brief    Gets the depth of a sprite.
-     *  @return   depth value that can be written into the z buffer.
-     */
-    u8 spriteDepth(u8 nr);
-    
     /*! @brief    Compares the Y coordinates of all sprites with the yCounter
      *  @return   A bit pattern storing the result for each sprite.
      */
@@ -1267,50 +1530,54 @@ public:
     
 	/*! @brief    Executes a specific rasterline cycle
      *  @note     The cycle specific actions differ depending on the selected
-     *            chip model.
-     */
-    void cycle1pal();   void cycle1ntsc();
-    void cycle2pal();   void cycle2ntsc();
-    void cycle3pal();   void cycle3ntsc();
-    void cycle4pal();   void cycle4ntsc();
-    void cycle5pal();   void cycle5ntsc();
-    void cycle6pal();   void cycle6ntsc();
-    void cycle7pal();   void cycle7ntsc();
-    void cycle8pal();   void cycle8ntsc();
-    void cycle9pal();   void cycle9ntsc();
-    void cycle10pal();  void cycle10ntsc();
-    void cycle11pal();  void cycle11ntsc();
-    void cycle12();
-    void cycle13();
-    void cycle14();
-    void cycle15();
-    void cycle16();
-    void cycle17();
-    void cycle18();
-    void cycle19to54();
-    void cycle55pal();  void cycle55ntsc();
-    void cycle56();
-    void cycle57pal();  void cycle57ntsc();
-    void cycle58pal();  void cycle58ntsc();
-    void cycle59pal();  void cycle59ntsc();
-    void cycle60pal();  void cycle60ntsc();
-    void cycle61pal();  void cycle61ntsc();
-    void cycle62pal();  void cycle62ntsc();
-    void cycle63pal();  void cycle63ntsc();
-    void cycle64ntsc();
-    void cycle65ntsc();
+     *            chip model. All cycle functions are instantiated for each
+     *            emulated chip flavour (PAL_6569_R3 also stands for
+     *            PAL_6569_R1), so that no model checks are left in the
+     *            instantiated code.
+     *  @see      C64::updateVicFunctionTable()
+     */
+    template <VICModel model> void cycle1pal();  template <VICModel model> void cycle1ntsc();
+    template <VICModel model> void cycle2pal();  template <VICModel model> void cycle2ntsc();
+    template <VICModel model> void cycle3pal();  template <VICModel model> void cycle3ntsc();
+    template <VICModel model> void cycle4pal();  template <VICModel model> void cycle4ntsc();
+    template <VICModel model> void cycle5pal();  template <VICModel model> void cycle5ntsc();
+    template <VICModel model> void cycle6pal();  template <VICModel model> void cycle6ntsc();
+    template <VICModel model> void cycle7pal();  template <VICModel model> void cycle7ntsc();
+    template <VICModel model> void cycle8pal();  template <VICModel model> void cycle8ntsc();
+    template <VICModel model> void cycle9pal();  template <VICModel model> void cycle9ntsc();
+    template <VICModel model> void cycle10pal(); template <VICModel model> void cycle10ntsc();
+    template <VICModel model> void cycle11pal(); template <VICModel model> void cycle11ntsc();
+    template <VICModel model> void cycle12();
+    template <VICModel model> void cycle13();
+    template <VICModel model> void cycle14();
+    template <VICModel model> void cycle15();
+    template <VICModel model> void cycle16();
+    template <VICModel model> void cycle17();
+    template <VICModel model> void cycle18();
+    template <VICModel model> void cycle19to54();
+    template <VICModel model> void cycle55pal(); template <VICModel model> void cycle55ntsc();
+    template <VICModel model> void cycle56();
+    template <VICModel model> void cycle57pal(); template <VICModel model> void cycle57ntsc();
+    template <VICModel model> void cycle58pal(); template <VICModel model> void cycle58ntsc();
+    template <VICModel model> void cycle59pal(); template <VICModel model> void cycle59ntsc();
+    template <VICModel model> void cycle60pal(); template <VICModel model> void cycle60ntsc();
+    template <VICModel model> void cycle61pal(); template <VICModel model> void cycle61ntsc();
+    template <VICModel model> void cycle62pal(); template <VICModel model> void cycle62ntsc();
+    template <VICModel model> void cycle63pal(); template <VICModel model> void cycle63ntsc();
+    template <VICModel model> void cycle64ntsc();
+    template <VICModel model> void cycle65ntsc();
 	
-    #define DRAW_SPRITES if (spriteDisplay || isSecondDMAcycle) drawSprites();
-    #define DRAW_SPRITES59 if (spriteDisplayDelayed || spriteDisplay || isSecondDMAcycle) drawSprites();
+    #define DRAW_SPRITES if (spriteDisplay || isSecondDMAcycle) drawSprites<model>();
+    #define DRAW_SPRITES59 if (spriteDisplayDelayed || spriteDisplay || isSecondDMAcycle) drawSprites<model>();
 
-    #define DRAW if (!vblank) draw(); DRAW_SPRITES; bufferoffset += 8;
-    #define DRAW17 if (!vblank) draw17(); DRAW_SPRITES; bufferoffset += 8;
-    #define DRAW55 if (!vblank) draw55(); DRAW_SPRITES; bufferoffset += 8;
-    #define DRAW59 if (!vblank) draw(); DRAW_SPRITES59; bufferoffset += 8;
+    #define DRAW if (!vblank) draw<model>(); DRAW_SPRITES; bufferoffset += 8;
+    #define DRAW17 if (!vblank) draw17<model>(); DRAW_SPRITES; bufferoffset += 8;
+    #define DRAW55 if (!vblank) draw55<model>(); DRAW_SPRITES; bufferoffset += 8;
+    #define DRAW59 if (!vblank) draw<model>(); DRAW_SPRITES59; bufferoffset += 8;
     #define DRAW_IDLE DRAW_SPRITES;
 /*
     #define DRAW_IDLE
-    for (unsigned i = 0; i < 8; i++) { zBuffer[i] = pixelSource[i] = 0; } \
+    foregroundPixels = backgroundPixels = 0; \
     DRAW_SPRITES;
 */
     
@@ -1319,7 +1586,7 @@ public:
     #define END_CYCLE \
     dataBusPhi2 = 0xFF; \
     xCounter += 8; \
-    for (unsigned i = 0; i < 8; i++) { zBuffer[i] = pixelSource[i] = 0; } \
+    foregroundPixels = backgroundPixels = 0; \
     if (unlikely(delay)) { processDelayedActions(); }
 
     #define END_VISIBLE_CYCLE \
@@ -1344,13 +1611,93 @@ private:
      *            each drawing cycle. An exception are cycle 17 and cycle 55
      *            which are handled seperately for speedup reasons.
      */
-    void draw();
+    template <VICModel model> void draw();
     
     //! @brief    Special draw routine for cycle 17
-    void draw17();
+    template <VICModel model> void draw17();
     
     //! @brief    Special draw routine for cycle 55
-    void draw55();
+    template <VICModel model> void draw55();
+    
+    /*! @brief    Records the inputs of a drawing cycle on a quiet rasterline
+     *  @details  Returns false if the cycle needs to be drawn right away.
+     *            In that case, the rasterline stops being quiet.
+     */
+    bool deferDrawing(u8 variant) {
+        
+        if (spriteDisplay | spriteDisplayDelayed | spriteSrActive) {
+            leaveQuietLine();
+            return false;
+        }
+        
+        QuietCycle &c = quietCycles[numQuietCycles++];
+        c.gAccess = sr.canLoad ? gAccessResult.delayed() : 0;
+        c.bufferoffset = bufferoffset;
+        c.variant = variant;
+        c.canLoad = sr.canLoad;
+        c.vertical = flipflops.delayed.vertical;
+        c.mainDelayed = flipflops.delayed.main;
+        c.mainCurrent = flipflops.current.main;
+        return true;
+    }
+    
+    //! @brief    Checks if the registers used for drawing won't change.
+    bool drawingRegistersSettled() {
+        return
+        reg.delayed.ctrl1 == reg.current.ctrl1 &&
+        reg.delayed.ctrl2 == reg.current.ctrl2 &&
+        memcmp(reg.delayed.colors, reg.current.colors, COLREG_BG3 + 1) == 0;
+    }
+    
+    /*! @brief    Draws all recorded cycles of a quiet rasterline
+     *  @details  Called whenever the rasterline stops being quiet and at the
+     *            end of a quiet rasterline that isn't handed over to the
+     *            render thread.
+     */
+    void leaveQuietLine() {
+        if (quietLine) {
+            quietLine = false;
+            drawQuietLine();
+        }
+    }
+    
+    //! @brief    Draws all recorded cycles with the canvas and border logic.
+    void drawQuietLine();
+    
+    /*! @brief    Draws recorded cycles into a rasterline
+     *  @details  Only reads the provided register values. Hence, this
+     *            function can be called by the render thread.
+     */
+    void drawQuietCycles(u8 *line, u8 ctrl1, u8 ctrl2, const u8 *colors,
+                         const QuietCycle *cycles, unsigned count);
+    
+    /*! @brief    Draws recorded cycles in a single display mode
+     *  @details  drawQuietCycles() picks the instance that matches the
+     *            settled values of D011 and D016.
+     */
+    template <DisplayMode mode> void drawQuietSpan(u8 *line, u8 xscroll,
+                                                   const u8 *colors,
+                                                   const QuietCycle *cycles,
+                                                   unsigned count);
+    
+    /*! @brief    Draws the canvas pixels of a recorded cycle
+     *  @details  Same as drawCanvas() under the assumption that no register
+     *            changes.
+     */
+    template <DisplayMode mode> void drawQuietCanvas(const QuietCycle &c, u8 *pixels,
+                                                     u8 xscroll, const u8 *colors);
+    
+    //! @brief    Same as loadColors() for a display mode known at compile time
+    template <DisplayMode mode> void loadQuietColors(const u8 *colors);
+    
+    //! @brief    Hands over the current quiet rasterline to the render thread
+    void logQuietLine();
+    
+    //! @brief    Blocks until the render thread has drawn all pending records
+    void waitForRenderer();
+    
+    //! @brief    Terminates the render thread and frees the render log
+    void stopRenderThread();
         
     
     //
@@ -1375,7 +1722,29 @@ private:
     /*! @brief    Draws 8 canvas pixels
      *  @seealso  draw()
      */
-    void drawCanvas();
+    template <VICModel model> void drawCanvas();
+    
+    /*! @brief    Checks if drawing can be omitted in the current cycle
+     *  @details  Drawing is omitted inside a skipped frame if no sprite can
+     *            show up in the current cycle. When drawing resumes, sprites
+     *            have been switched on in cycle 58 at the earliest. At that
+     *            time, the shift register has been drained completely by all
+     *            pixels following the last graphics access.
+     *  @seealso  lazyCanvas
+     */
+    bool omitDrawing() {
+        if (lazyCanvas && !(spriteDisplay | spriteDisplayDelayed | spriteSrActive)) {
+            canvasOmitted = true;
+            return true;
+        }
+        if (canvasOmitted) {
+            if (renderPending) waitForRenderer();
+            sr.data = 0;
+            sr.colorbits = 0;
+            canvasOmitted = false;
+        }
+        return false;
+    }
     
     /*! @brief    Draws a single canvas pixel
      *  @param    pixel is the pixel number and must be in the range 0 to 7
@@ -1394,20 +1763,31 @@ private:
                          bool updateColors);
     
     /*! @brief    Draws 8 sprite pixels
+     *  @details  The sprites are processed one after another. Each sprite
+     *            yields a mask of the pixels it covers. Priorities and
+     *            collisions are resolved by combining these masks with the
+     *            canvas layer masks.
      *  @seealso  draw()
      */
-    void drawSprites();
+    template <VICModel model> void drawSprites();
     
-    /*! @brief    Draws a single sprite pixel for all sprites
+    /*! @brief    Runs the shift register of a single sprite for one pixel
+     *  @param    sprite   Sprite number (0 to 7)
      *  @param    pixel    Pixel number (0 to 7)
-     *  @param    enableBits are the spriteDisplay bits
-     *  @param    freezeBits If set to true, the sprites shift register will
-     *                     freeze temporarily
+     *  @param    enable   Display bit of the sprite
+     *  @param    freeze   If set to true, the shift register freezes
+     *                     temporarily
+     *  @param    mCol     Multicolor bit of the sprite
+     *  @param    xExp     X expansion bit of the sprite
+     *  @return   The color bits of the pixel or 0 if the pixel is transparent
      *  @seealso  drawSprites()
      */
-    void drawSpritePixel(unsigned pixel,
-                         u8 enableBits,
-                         u8 freezeBits);
+    u8 drawSpritePixel(unsigned sprite,
+                       unsigned pixel,
+                       bool enable,
+                       bool freeze,
+                       bool mCol,
+                       bool xExp);
     
     
     //
@@ -1415,7 +1795,10 @@ private:
     //
     
     //! @brief    Determines pixel colors accordig to the provided display mode
-    void loadColors(u8 mode);
+    void loadColors(u8 mode) { loadColors(mode, reg.delayed.colors); }
+    
+    //! @brief    Determines pixel colors from the provided color registers
+    void loadColors(u8 mode, const u8 *colors);
     
     
     //
@@ -1425,37 +1808,34 @@ private:
     //! @brief    Writes a single color value into the screenbuffer
     #define COLORIZE(pixel,color) \
         assert(bufferoffset + pixel < NTSC_PIXELS); \
-        pixelBuffer[bufferoffset + pixel] = rgbaTable[color];
+        pixelBuffer[bufferoffset + pixel] = color;
     
     /*! @brief    Sets a single frame pixel
-     *! @note     The upper bit in pixelSource is cleared to prevent
+     *! @note     The pixel is removed from both canvas layers to prevent
      *            sprite/foreground collision detection in border area.
      */
     #define SET_FRAME_PIXEL(pixel,color) { \
         COLORIZE(pixel, color); \
-        zBuffer[pixel] = BORDER_LAYER_DEPTH; \
-        pixelSource[pixel] &= (~0x100); }
+        foregroundPixels &= ~(1 << (pixel)); \
+        backgroundPixels &= ~(1 << (pixel)); }
     
     //! @brief    Sets a single foreground pixel
     #define SET_FOREGROUND_PIXEL(pixel,color) { \
         COLORIZE(pixel,color) \
-        zBuffer[pixel] = FOREGROUND_LAYER_DEPTH; \
-        pixelSource[pixel] = 0x100; }
+        foregroundPixels |= (1 << (pixel)); \
+        backgroundPixels &= ~(1 << (pixel)); }
 
     //! @brief    Sets a single background pixel
     #define SET_BACKGROUND_PIXEL(pixel,color) { \
         COLORIZE(pixel,color) \
-        zBuffer[pixel] = BACKGROUD_LAYER_DEPTH; \
-        pixelSource[pixel] = 0x00; }
-    
-    //! @brief    Draw a single sprite pixel
-    void setSpritePixel(unsigned sprite, unsigned pixel, u8 color);
+        foregroundPixels &= ~(1 << (pixel)); \
+        backgroundPixels |= (1 << (pixel)); }
     
     /*! @brief    Extend border to the left and right to look nice.
      *  @details  This functions replicates the color of the leftmost and
      *            rightmost pixel
      */
-    void expandBorders();
+    void expandBorders(u8 *line, bool pal);
     
     /*! @brief    Draw a horizontal colored line into the screen buffer
      *  @details  This method is utilized for debugging purposes, only.
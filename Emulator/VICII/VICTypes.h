@@ -268,6 +268,18 @@ inline bool isGlueLogic(GlueLogic type) {
     (type == GLUE_CUSTOM_IC);
 }
 
+//! @brief    Pixel formats of the screen buffers
+typedef enum {
+    SCREEN_RGBA = 0,
+    SCREEN_INDEXED = 1
+} ScreenFormat;
+
+inline bool isScreenFormat(ScreenFormat format) {
+    return
+    (format == SCREEN_RGBA) ||
+    (format == SCREEN_INDEXED);
+}
+
 //! @brief    Screen geometries
 typedef enum {
     COL_40_ROW_25 = 0x01,
@@ -13,6 +13,12 @@
 
 #include "VIC.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 double gammaCorrect(double value, double source, double target)
 {
     // Reverse gamma correction of source
@@ -443,4 +449,100 @@ VIC::updatePalette()
     }
 }
 
+/* Color conversion
+ *
+ * The sixteen RGBA values are split into four tables of sixteen bytes, one for
+ * each byte of a pixel. A single byte shuffle looks up one of these bytes for
+ * sixteen color numbers at once. The four results are interleaved into sixteen
+ * RGBA pixels. On x86, the shuffle instruction requires SSSE3 which is checked
+ * at runtime. On ARM, NEON is always present.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("ssse3"))) static size_t
+convertSSSE3(const u8 *src, u32 *dst, size_t count, const u8 (*channel)[16])
+{
+    __m128i t0 = _mm_loadu_si128((const __m128i *)channel[0]);
+    __m128i t1 = _mm_loadu_si128((const __m128i *)channel[1]);
+    __m128i t2 = _mm_loadu_si128((const __m128i *)channel[2]);
+    __m128i t3 = _mm_loadu_si128((const __m128i *)channel[3]);
+    
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        
+        __m128i idx = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i c0 = _mm_shuffle_epi8(t0, idx);
+        __m128i c1 = _mm_shuffle_epi8(t1, idx);
+        __m128i c2 = _mm_shuffle_epi8(t2, idx);
+        __m128i c3 = _mm_shuffle_epi8(t3, idx);
+        
+        __m128i lo01 = _mm_unpacklo_epi8(c0, c1);
+        __m128i hi01 = _mm_unpackhi_epi8(c0, c1);
+        __m128i lo23 = _mm_unpacklo_epi8(c2, c3);
+        __m128i hi23 = _mm_unpackhi_epi8(c2, c3);
+        
+        _mm_storeu_si128((__m128i *)(dst + i +  0), _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *)(dst + i +  4), _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *)(dst + i +  8), _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128((__m128i *)(dst + i + 12), _mm_unpackhi_epi16(hi01, hi23));
+    }
+    return i;
+}
+
+static size_t
+convertVector(const u8 *src, u32 *dst, size_t count, const u8 (*channel)[16])
+{
+    static const bool ssse3 = __builtin_cpu_supports("ssse3");
+    return ssse3 ? convertSSSE3(src, dst, count, channel) : 0;
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+static size_t
+convertVector(const u8 *src, u32 *dst, size_t count, const u8 (*channel)[16])
+{
+    uint8x16_t t0 = vld1q_u8(channel[0]);
+    uint8x16_t t1 = vld1q_u8(channel[1]);
+    uint8x16_t t2 = vld1q_u8(channel[2]);
+    uint8x16_t t3 = vld1q_u8(channel[3]);
+    
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        
+        uint8x16_t idx = vld1q_u8(src + i);
+        uint8x16x4_t pixels = {{
+            vqtbl1q_u8(t0, idx), vqtbl1q_u8(t1, idx),
+            vqtbl1q_u8(t2, idx), vqtbl1q_u8(t3, idx) }};
+        vst4q_u8((u8 *)(dst + i), pixels);
+    }
+    return i;
+}
+
+#else
+
+static size_t
+convertVector(const u8 *src, u32 *dst, size_t count, const u8 (*channel)[16])
+{
+    return 0;
+}
+
+#endif
 
+void
+VIC::convertToRGBA(const u8 *src, u32 *dst, size_t count)
+{
+    u8 channel[4][16];
+    
+    // Split the color table into bytes (in memory order)
+    for (unsigned i = 0; i < 16; i++) {
+        for (unsigned j = 0; j < 4; j++) {
+            channel[j][i] = ((u8 *)&rgbaTable[i])[j];
+        }
+    }
+    
+    // Convert the bulk of the pixels and finish the remaining ones one by one
+    for (size_t i = convertVector(src, dst, count, channel); i < count; i++) {
+        dst[i] = rgbaTable[src[i] & 0x0F];
+    }
+}
@@ -9,7 +9,7 @@
 
 #include "C64.h"
 
-void
+template <VICModel model> void
 VIC::cycle1ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -40,7 +40,7 @@ VIC::cycle1ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle2ntsc()
 {
     // Check for lightpen IRQ in first rasterline
@@ -51,7 +51,7 @@ VIC::cycle2ntsc()
     sThirdAccess(3);
 
     // Check for yCounter overflows
-    if (yCounterOverflow())
+    if (yCounterOverflow<model>())
         yCounter = 0;
     
     // Phi1.1 Frame logic
@@ -76,7 +76,7 @@ VIC::cycle2ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle3ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -97,7 +97,7 @@ VIC::cycle3ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle4ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -119,7 +119,7 @@ VIC::cycle4ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle5ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -140,7 +140,7 @@ VIC::cycle5ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle6ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -162,7 +162,7 @@ VIC::cycle6ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle7ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -183,7 +183,7 @@ VIC::cycle7ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle8ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -205,7 +205,7 @@ VIC::cycle8ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle9ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -226,7 +226,7 @@ VIC::cycle9ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle10ntsc()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -248,7 +248,7 @@ VIC::cycle10ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle11ntsc()
 {
     // Phi1.1 Frame logic
@@ -266,7 +266,7 @@ VIC::cycle11ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle55ntsc()
 {
     // Phi1.1 Frame logic
@@ -276,7 +276,7 @@ VIC::cycle55ntsc()
     DRAW
 
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.2 Sprite logic
     turnSpriteDmaOn();
@@ -287,7 +287,7 @@ VIC::cycle55ntsc()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle57ntsc()
 {
     // Phi1.1 Frame logic
@@ -307,7 +307,7 @@ VIC::cycle57ntsc()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle58ntsc()
 {
     // Phi1.1 Frame logic
@@ -347,7 +347,7 @@ VIC::cycle58ntsc()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle59ntsc()
 {
     // Phi1.1 Frame logic
@@ -371,7 +371,7 @@ VIC::cycle59ntsc()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle60ntsc()
 {
     // Phi1.1 Frame logic
@@ -392,7 +392,7 @@ VIC::cycle60ntsc()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle61ntsc()
 {
     // Phi1.1 Frame logic
@@ -416,7 +416,7 @@ VIC::cycle61ntsc()
     // visibleColumnCnt = 0;
 }
 
-void
+template <VICModel model> void
 VIC::cycle62ntsc()
 {
     // Phi1.1 Frame logic
@@ -437,7 +437,7 @@ VIC::cycle62ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle63ntsc()
 {
     // Phi1.1 Frame logic
@@ -459,7 +459,7 @@ VIC::cycle63ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle64ntsc()
 {
     // Phi1.1 Frame logic
@@ -481,7 +481,7 @@ VIC::cycle64ntsc()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle65ntsc()
 {
     // Phi1.1 Frame logic
@@ -504,5 +504,35 @@ VIC::cycle65ntsc()
     END_CYCLE
 }
 
+//
+// Instantiate the cycle functions for all chip flavours
+//
 
-
+#define INSTANTIATE_CYCLES(model) \
+template void VIC::cycle1ntsc<model>(); \
+template void VIC::cycle2ntsc<model>(); \
+template void VIC::cycle3ntsc<model>(); \
+template void VIC::cycle4ntsc<model>(); \
+template void VIC::cycle5ntsc<model>(); \
+template void VIC::cycle6ntsc<model>(); \
+template void VIC::cycle7ntsc<model>(); \
+template void VIC::cycle8ntsc<model>(); \
+template void VIC::cycle9ntsc<model>(); \
+template void VIC::cycle10ntsc<model>(); \
+template void VIC::cycle11ntsc<model>(); \
+template void VIC::cycle55ntsc<model>(); \
+template void VIC::cycle57ntsc<model>(); \
+template void VIC::cycle58ntsc<model>(); \
+template void VIC::cycle59ntsc<model>(); \
+template void VIC::cycle60ntsc<model>(); \
+template void VIC::cycle61ntsc<model>(); \
+template void VIC::cycle62ntsc<model>(); \
+template void VIC::cycle63ntsc<model>(); \
+template void VIC::cycle64ntsc<model>(); \
+template void VIC::cycle65ntsc<model>();
+
+INSTANTIATE_CYCLES(PAL_6569_R3)
+INSTANTIATE_CYCLES(PAL_8565)
+INSTANTIATE_CYCLES(NTSC_6567_R56A)
+INSTANTIATE_CYCLES(NTSC_6567)
+INSTANTIATE_CYCLES(NTSC_8562)
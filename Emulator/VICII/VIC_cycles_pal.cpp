@@ -62,7 +62,7 @@ VIC::processDelayedActions()
     delay = (delay << 1) & VICClearanceMask;
 }
 
-void
+template <VICModel model> void
 VIC::cycle1pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -94,7 +94,7 @@ VIC::cycle1pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle2pal()
 {
     // Check for lightpen IRQ in first rasterline
@@ -105,7 +105,7 @@ VIC::cycle2pal()
     sFirstAccess(3);
 
     // Check for yCounter overflows
-    if (yCounterOverflow())
+    if (yCounterOverflow<model>())
         yCounter = 0;
     
     // Phi1.1 Frame logic
@@ -129,7 +129,7 @@ VIC::cycle2pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle3pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -151,7 +151,7 @@ VIC::cycle3pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle4pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -173,7 +173,7 @@ VIC::cycle4pal()
 }
 
 
-void
+template <VICModel model> void
 VIC::cycle5pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -195,7 +195,7 @@ VIC::cycle5pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle6pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -216,7 +216,7 @@ VIC::cycle6pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle7pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -238,7 +238,7 @@ VIC::cycle7pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle8pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -259,7 +259,7 @@ VIC::cycle8pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle9pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -281,7 +281,7 @@ VIC::cycle9pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle10pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -302,7 +302,7 @@ VIC::cycle10pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle11pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -324,7 +324,7 @@ VIC::cycle11pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle12()
 {
     // Phi1.1 Frame logic
@@ -351,7 +351,7 @@ VIC::cycle12()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle13() // X Coordinate -3 - 4 (?)
 {
     // Phi1.1 Frame logic
@@ -369,7 +369,7 @@ VIC::cycle13() // X Coordinate -3 - 4 (?)
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle14() // SpriteX: 0 - 7 (?)
 {
     // Phi1.1 Frame logic
@@ -401,7 +401,7 @@ VIC::cycle14() // SpriteX: 0 - 7 (?)
     xCounter = 0;
 }
 
-void
+template <VICModel model> void
 VIC::cycle15() // SpriteX: 8 - 15 (?)
 {
     // Phi1.1 Frame logic
@@ -423,7 +423,7 @@ VIC::cycle15() // SpriteX: 8 - 15 (?)
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle16() // SpriteX: 16 - 23 (?)
 {
     // Phi1.1 Frame logic
@@ -433,7 +433,7 @@ VIC::cycle16() // SpriteX: 16 - 23 (?)
     DRAW
   
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.2 Sprite logic
     turnSpriteDmaOff();
@@ -447,7 +447,7 @@ VIC::cycle16() // SpriteX: 16 - 23 (?)
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle17() // SpriteX: 24 - 31 (?)
 {
     // Phi1.1 Frame logic
@@ -458,7 +458,7 @@ VIC::cycle17() // SpriteX: 24 - 31 (?)
     DRAW
     
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.4 BA logic
     BA_LINE(badLine);
@@ -469,7 +469,7 @@ VIC::cycle17() // SpriteX: 24 - 31 (?)
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle18() // SpriteX: 32 - 39
 {
     // Phi1.1 Frame logic
@@ -481,7 +481,7 @@ VIC::cycle18() // SpriteX: 32 - 39
     DRAW17
   
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.4 BA logic
     BA_LINE(badLine);
@@ -492,7 +492,7 @@ VIC::cycle18() // SpriteX: 32 - 39
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle19to54()
 {
     // Phi1.1 Frame logic
@@ -502,7 +502,7 @@ VIC::cycle19to54()
     DRAW
     
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.4 BA logic
     BA_LINE(badLine);
@@ -513,7 +513,7 @@ VIC::cycle19to54()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle55pal()
 {
     // Phi1.1 Frame logic
@@ -523,7 +523,7 @@ VIC::cycle55pal()
     DRAW
   
     // Phi1.3 Fetch
-    gAccess();
+    gAccess<model>();
     
     // Phi2.2 Sprite logic
     turnSpriteDmaOn();
@@ -534,7 +534,7 @@ VIC::cycle55pal()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle56()
 {
     // Phi1.1 Frame logic
@@ -557,7 +557,7 @@ VIC::cycle56()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle57pal()
 {
     // Phi1.1 Frame logic
@@ -577,7 +577,7 @@ VIC::cycle57pal()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle58pal()
 {
     // Phi1.1 Frame logic
@@ -617,7 +617,7 @@ VIC::cycle58pal()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle59pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -641,7 +641,7 @@ VIC::cycle59pal()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle60pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -663,7 +663,7 @@ VIC::cycle60pal()
     END_VISIBLE_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle61pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -686,7 +686,7 @@ VIC::cycle61pal()
     // visibleColumnCnt = 0;
 }
 
-void
+template <VICModel model> void
 VIC::cycle62pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -708,7 +708,7 @@ VIC::cycle62pal()
     END_CYCLE
 }
 
-void
+template <VICModel model> void
 VIC::cycle63pal()
 {
     // Phi2.5 Fetch (previous cycle)
@@ -729,3 +729,43 @@ VIC::cycle63pal()
     
     END_CYCLE
 }
+
+//
+// Instantiate the cycle functions for all chip flavours
+//
+
+#define INSTANTIATE_CYCLES(model) \
+template void VIC::cycle1pal<model>(); \
+template void VIC::cycle2pal<model>(); \
+template void VIC::cycle3pal<model>(); \
+template void VIC::cycle4pal<model>(); \
+template void VIC::cycle5pal<model>(); \
+template void VIC::cycle6pal<model>(); \
+template void VIC::cycle7pal<model>(); \
+template void VIC::cycle8pal<model>(); \
+template void VIC::cycle9pal<model>(); \
+template void VIC::cycle10pal<model>(); \
+template void VIC::cycle11pal<model>(); \
+template void VIC::cycle12<model>(); \
+template void VIC::cycle13<model>(); \
+template void VIC::cycle14<model>(); \
+template void VIC::cycle15<model>(); \
+template void VIC::cycle16<model>(); \
+template void VIC::cycle17<model>(); \
+template void VIC::cycle18<model>(); \
+template void VIC::cycle19to54<model>(); \
+template void VIC::cycle55pal<model>(); \
+template void VIC::cycle56<model>(); \
+template void VIC::cycle57pal<model>(); \
+template void VIC::cycle58pal<model>(); \
+template void VIC::cycle59pal<model>(); \
+template void VIC::cycle60pal<model>(); \
+template void VIC::cycle61pal<model>(); \
+template void VIC::cycle62pal<model>(); \
+template void VIC::cycle63pal<model>();
+
+INSTANTIATE_CYCLES(PAL_6569_R3)
+INSTANTIATE_CYCLES(PAL_8565)
+INSTANTIATE_CYCLES(NTSC_6567_R56A)
+INSTANTIATE_CYCLES(NTSC_6567)
+INSTANTIATE_CYCLES(NTSC_8562)
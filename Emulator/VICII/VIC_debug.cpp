@@ -105,6 +105,7 @@ void
 VIC::setDisplayMode(DisplayMode m)
 {
     suspend();
+    leaveQuietLine();
     reg.current.ctrl1 = (reg.current.ctrl1 & ~0x60) | (m & 0x60);
     reg.current.ctrl2 = (reg.current.ctrl2 & ~0x10) | (m & 0x10);
     delay |= VICUpdateRegisters;
@@ -163,6 +164,7 @@ VIC::setVerticalRasterScroll(u8 offset)
     assert(offset < 8);
     
     suspend();
+    leaveQuietLine();
     reg.current.ctrl1 = (reg.current.ctrl1 & 0xF8) | (offset & 0x07);
     delay |= VICUpdateRegisters;
     resume();
@@ -174,6 +176,7 @@ VIC::setHorizontalRasterScroll(u8 offset)
     assert(offset < 8);
     
     suspend();
+    leaveQuietLine();
     reg.current.ctrl2 = (reg.current.ctrl2 & 0xF8) | (offset & 0x07);
     delay |= VICUpdateRegisters;
     resume();
@@ -9,27 +9,207 @@
 
 #include "C64.h"
 
-void
+template <VICModel model> void
 VIC::draw()
 {
-    drawCanvas();
+    if (omitDrawing()) return;
+    if (quietLine && deferDrawing(0)) return;
+    
+    drawCanvas<model>();
     drawBorder();
 }
 
-void
+template <VICModel model> void
 VIC::draw17()
 {
-    drawCanvas();
+    if (omitDrawing()) return;
+    if (quietLine && deferDrawing(17)) return;
+    
+    drawCanvas<model>();
     drawBorder17();
 }
 
-void
+template <VICModel model> void
 VIC::draw55()
 {
-    drawCanvas();
+    if (omitDrawing()) return;
+    if (quietLine && deferDrawing(55)) return;
+    
+    drawCanvas<model>();
     drawBorder55();
 }
 
+void
+VIC::drawQuietLine()
+{
+    if (renderPending) waitForRenderer();
+    
+    drawQuietCycles(pixelBuffer, reg.delayed.ctrl1, reg.delayed.ctrl2,
+                    reg.delayed.colors, quietCycles, numQuietCycles);
+    numQuietCycles = 0;
+}
+
+void
+VIC::drawQuietCycles(u8 *line, u8 ctrl1, u8 ctrl2, const u8 *colors,
+                     const QuietCycle *cycles, unsigned count)
+{
+    u8 xscroll = ctrl2 & 0x07;
+    
+    switch ((ctrl1 & 0x60) | (ctrl2 & 0x10)) {
+            
+        case STANDARD_TEXT:
+            drawQuietSpan<STANDARD_TEXT>(line, xscroll, colors, cycles, count);
+            break;
+        case MULTICOLOR_TEXT:
+            drawQuietSpan<MULTICOLOR_TEXT>(line, xscroll, colors, cycles, count);
+            break;
+        case STANDARD_BITMAP:
+            drawQuietSpan<STANDARD_BITMAP>(line, xscroll, colors, cycles, count);
+            break;
+        case MULTICOLOR_BITMAP:
+            drawQuietSpan<MULTICOLOR_BITMAP>(line, xscroll, colors, cycles, count);
+            break;
+        case EXTENDED_BACKGROUND_COLOR:
+            drawQuietSpan<EXTENDED_BACKGROUND_COLOR>(line, xscroll, colors, cycles, count);
+            break;
+        case INVALID_TEXT:
+            drawQuietSpan<INVALID_TEXT>(line, xscroll, colors, cycles, count);
+            break;
+        case INVALID_STANDARD_BITMAP:
+            drawQuietSpan<INVALID_STANDARD_BITMAP>(line, xscroll, colors, cycles, count);
+            break;
+        default:
+            drawQuietSpan<INVALID_MULTICOLOR_BITMAP>(line, xscroll, colors, cycles, count);
+            break;
+    }
+}
+
+template <DisplayMode mode> void
+VIC::drawQuietSpan(u8 *line, u8 xscroll, const u8 *colors,
+                   const QuietCycle *cycles, unsigned count)
+{
+    u8 border = colors[COLREG_BORDER];
+    
+    for (unsigned i = 0; i < count; i++) {
+        
+        const QuietCycle &c = cycles[i];
+        u8 *pixels = line + c.bufferoffset;
+        
+        // Canvas
+        if (c.vertical) {
+            memset(pixels, col[0], 8);
+        } else {
+            drawQuietCanvas<mode>(c, pixels, xscroll, colors);
+        }
+        
+        // Border
+        if (c.variant == 17 && c.mainDelayed && !c.mainCurrent) {
+            memset(pixels, border, 7);
+        } else if (c.variant == 55 && !c.mainDelayed && c.mainCurrent) {
+            pixels[7] = border;
+        } else if (c.mainDelayed) {
+            memset(pixels, border, 8);
+        }
+    }
+}
+
+template <DisplayMode mode> void
+VIC::drawQuietCanvas(const QuietCycle &c, u8 *pixels,
+                     u8 xscroll, const u8 *colors)
+{
+    loadQuietColors<mode>(colors);
+    
+    for (unsigned pixel = 0; pixel < 8; pixel++) {
+        
+        if (pixel == xscroll && c.canLoad) {
+            
+            sr.data = BYTE0(c.gAccess);
+            sr.latchedCharacter = BYTE2(c.gAccess);
+            sr.latchedColor = BYTE1(c.gAccess);
+            sr.mcFlop = true;
+            sr.remainingBits = 8;
+            loadQuietColors<mode>(colors);
+        }
+        
+        if (!sr.remainingBits) {
+            sr.colorbits = 0;
+        }
+        
+        // With D016 being stable, the display mode matches the generated mode
+        if ((mode & 0x10) && ((mode & 0x20) || (sr.latchedColor & 0x8))) {
+            if (sr.mcFlop) {
+                sr.colorbits = sr.data >> 6;
+            }
+        } else {
+            sr.colorbits = sr.data >> 7;
+        }
+        
+        pixels[pixel] = col[sr.colorbits];
+        
+        sr.data <<= 1;
+        sr.mcFlop = !sr.mcFlop;
+        sr.remainingBits -= 1;
+    }
+}
+
+template <DisplayMode mode> void
+VIC::loadQuietColors(const u8 *colors)
+{
+    u8 character = sr.latchedCharacter;
+    u8 color = sr.latchedColor;
+    
+    switch (mode) {
+            
+        case STANDARD_TEXT:
+            
+            col[0] = colors[COLREG_BG0];
+            col[1] = color;
+            break;
+            
+        case MULTICOLOR_TEXT:
+            
+            col[0] = colors[COLREG_BG0];
+            if (color & 0x8 /* MC flag */) {
+                col[1] = colors[COLREG_BG1];
+                col[2] = colors[COLREG_BG2];
+                col[3] = color & 0x07;
+            } else {
+                col[1] = color;
+            }
+            break;
+            
+        case STANDARD_BITMAP:
+            
+            col[0] = character & 0xF;
+            col[1] = character >> 4;
+            break;
+            
+        case MULTICOLOR_BITMAP:
+            
+            col[0] = colors[COLREG_BG0];
+            col[1] = character >> 4;
+            col[2] = character & 0x0F;
+            col[3] = color;
+            break;
+            
+        case EXTENDED_BACKGROUND_COLOR:
+            
+            col[0] = colors[COLREG_BG0 + (character >> 6)];
+            col[1] = color;
+            break;
+            
+        case INVALID_TEXT:
+        case INVALID_STANDARD_BITMAP:
+        case INVALID_MULTICOLOR_BITMAP:
+            
+            col[0] = 0;
+            col[1] = 0;
+            col[2] = 0;
+            col[3] = 0;
+            break;
+    }
+}
+
 void
 VIC::drawBorder()
 {
@@ -73,11 +253,13 @@ VIC::drawBorder55()
     }
 }
 
-void
+template <VICModel model> void
 VIC::drawCanvas()
 {
     u8 d011, d016, newD016, mode, oldMode, xscroll;
     
+    if (renderPending) waitForRenderer();
+    
     /* "The sequencer outputs the graphics data in every raster line in the area
      *  of the display column as long as the vertical border flip-flop is reset
      *  (see section 3.9.)." [C.B.]
@@ -123,7 +305,7 @@ VIC::drawCanvas()
     newD016 = reg.current.ctrl2;
 
     // In older VICIIs, the one bits of D011 show up, too.
-    if (is656x()) {
+    if (is656x(model)) {
         d011 |= reg.current.ctrl1;
     }
     oldMode = mode;
@@ -133,7 +315,7 @@ VIC::drawCanvas()
     drawCanvasPixel(5, mode, d016, xscroll == 5, false);
     
     // In older VICIIs, the zero bits of D011 show up here.
-    if (is656x()) {
+    if (is656x(model)) {
         d011 = reg.current.ctrl1;
         oldMode = mode;
         mode = (d011 & 0x60) | (newD016 & 0x10);
@@ -240,199 +422,256 @@ VIC::drawCanvasPixel(u8 pixel,
     sr.remainingBits -= 1;
 }
 
-void
+template <VICModel model> void
 VIC::drawSprites()
 {
     u8 firstDMA = isFirstDMAcycle;
     u8 secondDMA = isSecondDMAcycle;
     
-    // Pixel 0
-    drawSpritePixel(0, spriteDisplayDelayed, secondDMA);
-    
-    // After the first pixel, color register changes show up
-    reg.delayed.colors[COLREG_SPR_EX1] = reg.current.colors[COLREG_SPR_EX1];
-    reg.delayed.colors[COLREG_SPR_EX2] = reg.current.colors[COLREG_SPR_EX2];
-    for (unsigned i = 0; i < 8; i++) {
-        reg.delayed.colors[COLREG_SPR0 + i] = reg.current.colors[COLREG_SPR0 + i];
-    }
-    
-    // Pixel 1, Pixel 2, Pixel 3
-    drawSpritePixel(1, spriteDisplayDelayed, secondDMA);
+    // Sprites that can change state or show up in this cycle
+    u8 candidates = spriteDisplayDelayed | spriteDisplay | spriteSrActive | secondDMA;
     
-    // Stop shift register on the second DMA cycle
-    spriteSrActive &= ~secondDMA;
+    // Multicolor bits that change in this cycle
+    u8 toggle = reg.delayed.sprMC ^ reg.current.sprMC;
     
-    drawSpritePixel(2, spriteDisplayDelayed, secondDMA);
-    drawSpritePixel(3, spriteDisplayDelayed, firstDMA | secondDMA);
+    // Pixels covered by at least one and at least two sprites
+    u8 covered = 0;
+    u8 overlapping = 0;
+    u8 coverage[8];
     
-    // If a shift register is loaded, the new data appears here.
-    updateSpriteShiftRegisters();
-
-    // Pixel 4, Pixel 5
-    drawSpritePixel(4, spriteDisplay, firstDMA | secondDMA);
-    drawSpritePixel(5, spriteDisplay, firstDMA | secondDMA);
-    
-    // Changes of the X expansion bits and the priority bits show up here
-    reg.delayed.sprExpandX = reg.current.sprExpandX;
-    reg.delayed.sprPriority = reg.current.sprPriority;
-
-    // Update multicolor bits if a new VICII is emulated
-    u8 toggle = reg.delayed.sprMC ^ reg.current.sprMC;
-    if (toggle && is856x()) {
+    for (unsigned sprite = 0; sprite < 8; sprite++) {
         
-        // VICE:
-        // BYTE next_mc_bits = vicii.regs[0x1c];
-        // BYTE toggled = next_mc_bits ^ sprite_mc_bits;
-        // sbuf_mc_flops ^= toggled & (~sbuf_expx_flops);
-        // sprite_mc_bits = next_mc_bits;
+        coverage[sprite] = 0;
+        if (!GET_BIT(candidates, sprite)) continue;
         
-        reg.delayed.sprMC = reg.current.sprMC;
-        for (unsigned i = 0; i < 8; i++) {
-            if (GET_BIT(toggle,i))
-                spriteSr[i].mcFlop ^= !spriteSr[i].expFlop;
+        bool enableDelayed = GET_BIT(spriteDisplayDelayed, sprite);
+        bool enable = GET_BIT(spriteDisplay, sprite);
+        bool first = GET_BIT(firstDMA, sprite);
+        bool second = GET_BIT(secondDMA, sprite);
+        bool mCol = GET_BIT(reg.delayed.sprMC, sprite);
+        bool xExp = GET_BIT(reg.delayed.sprExpandX, sprite);
+        u8 colBits[8];
+        
+        // Pixel 0, Pixel 1
+        colBits[0] = drawSpritePixel(sprite, 0, enableDelayed, second, mCol, xExp);
+        colBits[1] = drawSpritePixel(sprite, 1, enableDelayed, second, mCol, xExp);
+        
+        // Stop shift register on the second DMA cycle
+        if (second) CLR_BIT(spriteSrActive, sprite);
+        
+        // Pixel 2, Pixel 3
+        colBits[2] = drawSpritePixel(sprite, 2, enableDelayed, second, mCol, xExp);
+        colBits[3] = drawSpritePixel(sprite, 3, enableDelayed, first | second, mCol, xExp);
+        
+        // If the shift register is loaded, the new data appears here.
+        if (second) loadShiftRegister(sprite);
+        
+        // Pixel 4, Pixel 5
+        colBits[4] = drawSpritePixel(sprite, 4, enable, first | second, mCol, xExp);
+        colBits[5] = drawSpritePixel(sprite, 5, enable, first | second, mCol, xExp);
+        
+        // Changes of the X expansion bit show up here
+        xExp = GET_BIT(reg.current.sprExpandX, sprite);
+        
+        // Update the multicolor bit if a new VICII is emulated
+        if (GET_BIT(toggle, sprite) && is856x(model)) {
+            
+            // VICE:
+            // BYTE next_mc_bits = vicii.regs[0x1c];
+            // BYTE toggled = next_mc_bits ^ sprite_mc_bits;
+            // sbuf_mc_flops ^= toggled & (~sbuf_expx_flops);
+            // sprite_mc_bits = next_mc_bits;
+            
+            mCol = !mCol;
+            spriteSr[sprite].mcFlop ^= !spriteSr[sprite].expFlop;
+        }
+        
+        // Pixel 6
+        colBits[6] = drawSpritePixel(sprite, 6, enable, first | second, mCol, xExp);
+        
+        // Update the multicolor bit if an old VICII is emulated
+        if (GET_BIT(toggle, sprite) && is656x(model)) {
+            
+            mCol = !mCol;
+            spriteSr[sprite].mcFlop = 0;
+        }
+        
+        // Pixel 7
+        colBits[7] = drawSpritePixel(sprite, 7, enable, first, mCol, xExp);
+        
+        if (hideSprites) continue;
+        
+        // Collect the covered pixels
+        u8 mask = 0;
+        for (unsigned pixel = 0; pixel < 8; pixel++) {
+            if (colBits[pixel]) mask |= 1 << pixel;
+        }
+        if (!mask) continue;
+        
+        /* "the interesting case is when eg sprite 1 and sprite 0 overlap, and
+         *  sprite 0 has the priority bit set (and sprite 1 has not). in this
+         *  case 10/11 background bits show in front of whole sprite 0."
+         * Hence, a sprite never shows up on a pixel that is covered by a
+         * sprite with a lower number, even if that sprite is hidden by the
+         * foreground. Test program: VICII/spritePriorities
+         */
+        u8 behind =
+        (GET_BIT(reg.delayed.sprPriority, sprite) ? 0x3F : 0x00) |
+        (GET_BIT(reg.current.sprPriority, sprite) ? 0xC0 : 0x00);
+        u8 visible = mask & ~covered & (backgroundPixels | (foregroundPixels & ~behind));
+        
+        if (visible && isVisibleColumn) {
+            for (unsigned pixel = 0; pixel < 8; pixel++) {
+                
+                if (!GET_BIT(visible, pixel)) continue;
+                
+                // After the first pixel, color register changes show up
+                u8 *colors = pixel ? reg.current.colors : reg.delayed.colors;
+                
+                switch (colBits[pixel]) {
+                        
+                    case 0x01:
+                        COLORIZE(pixel, colors[COLREG_SPR_EX1]);
+                        break;
+                        
+                    case 0x02:
+                        COLORIZE(pixel, colors[COLREG_SPR0 + sprite]);
+                        break;
+                        
+                    case 0x03:
+                        COLORIZE(pixel, colors[COLREG_SPR_EX2]);
+                        break;
+                }
+            }
         }
+        
+        overlapping |= covered & mask;
+        covered |= mask;
+        coverage[sprite] = mask;
     }
     
-    // Pixel 6
-    drawSpritePixel(6, spriteDisplay, firstDMA | secondDMA);
-    
-    // Update multicolor bits if an old VICII is emulated
-    if (toggle && is656x()) {
-        
-        reg.delayed.sprMC = reg.current.sprMC;
-        for (unsigned i = 0; i < 8; i++) {
-            if (GET_BIT(toggle,i))
-                spriteSr[i].mcFlop = 0;
+    // Multicolor bit changes affect the remaining sprites, too
+    for (unsigned sprite = 0; sprite < 8; sprite++) {
+        if (GET_BIT(toggle & ~candidates, sprite)) {
+            if (is856x(model)) {
+                spriteSr[sprite].mcFlop ^= !spriteSr[sprite].expFlop;
+            } else {
+                spriteSr[sprite].mcFlop = 0;
+            }
         }
     }
     
-    // Pixel 7
-    drawSpritePixel(7, spriteDisplay, firstDMA);
+    // Apply all register changes that have shown up in this cycle
+    reg.delayed.colors[COLREG_SPR_EX1] = reg.current.colors[COLREG_SPR_EX1];
+    reg.delayed.colors[COLREG_SPR_EX2] = reg.current.colors[COLREG_SPR_EX2];
+    for (unsigned i = 0; i < 8; i++) {
+        reg.delayed.colors[COLREG_SPR0 + i] = reg.current.colors[COLREG_SPR0 + i];
+    }
+    reg.delayed.sprExpandX = reg.current.sprExpandX;
+    reg.delayed.sprPriority = reg.current.sprPriority;
+    reg.delayed.sprMC = reg.current.sprMC;
     
     // Check for collisions
-    for (unsigned i = 0; i < 8; i++) {
+    if (overlapping | (covered & foregroundPixels)) {
+        
+        u8 spriteSprite = 0;
+        u8 spriteBackground = 0;
         
-        // Check if two or more bits are set in pixelSource
-        if (pixelSource[i] & (pixelSource[i] - 1)) {
+        for (unsigned i = 0; i < 8; i++) {
+            if (coverage[i] & overlapping) SET_BIT(spriteSprite, i);
+            if (coverage[i] & foregroundPixels) SET_BIT(spriteBackground, i);
+        }
+        
+        // Is it a sprite/sprite collision?
+        if (spriteSprite) {
             
-            // Is it a sprite/sprite collision?
-            if ((pixelSource[i] & 0xFF) & ((pixelSource[i] & 0xFF) - 1)) {
-                
-                // Trigger an IRQ if this is the first detected collision
-                if (!spriteSpriteCollision) {
-                    triggerIrq(4);
-                }
-                spriteSpriteCollision |= (pixelSource[i] & 0xFF);
+            // Trigger an IRQ if this is the first detected collision
+            if (!spriteSpriteCollision) {
+                triggerIrq(4);
             }
+            spriteSpriteCollision |= spriteSprite;
+        }
+        
+        // Is it a sprite/background collision?
+        if (spriteBackground && spriteBackgroundCollisionEnabled) {
             
-            // Is it a sprite/background collision?
-            if ((pixelSource[i] & 0x100) && spriteBackgroundCollisionEnabled) {
-                
-                // Trigger an IRQ if this is the first detected collision
-                if (!spriteBackgroundColllision) {
-                    triggerIrq(2);
-                }
-                spriteBackgroundColllision |= (pixelSource[i] & 0xFF);
+            // Trigger an IRQ if this is the first detected collision
+            if (!spriteBackgroundColllision) {
+                triggerIrq(2);
             }
+            spriteBackgroundColllision |= spriteBackground;
         }
     }
 }
 
-void
-VIC::drawSpritePixel(unsigned pixel,
-                     u8 enableBits,
-                     u8 freezeBits)
+u8
+VIC::drawSpritePixel(unsigned sprite,
+                     unsigned pixel,
+                     bool enable,
+                     bool freeze,
+                     bool mCol,
+                     bool xExp)
 {
-    // Quick exit condition
-    if (!enableBits && !spriteSrActive) {
-        return;
-    }
+    bool active = GET_BIT(spriteSrActive, sprite);
     
-    // Iterate over all sprites
-    for (unsigned sprite = 0; sprite < 8; sprite++) {
-        
-        bool enable = GET_BIT(enableBits, sprite);
-        bool freeze = GET_BIT(freezeBits, sprite);
-        bool mCol = GET_BIT(reg.delayed.sprMC, sprite);
-        bool xExp = GET_BIT(reg.delayed.sprExpandX, sprite);
-        bool active = GET_BIT(spriteSrActive, sprite);
-        
-        // If a sprite is enabled, activate it's shift register if the
-        // horizontal trigger condition holds.
-        if (enable) {
-            if (!active && xCounter + pixel == reg.delayed.sprX[sprite] && !freeze) {
-                
-                SET_BIT(spriteSrActive, sprite);
-                active = true;
-                spriteSr[sprite].expFlop = true;
-                spriteSr[sprite].mcFlop = true;
-            }
+    // If a sprite is enabled, activate it's shift register if the
+    // horizontal trigger condition holds.
+    if (enable) {
+        if (!active && xCounter + pixel == reg.delayed.sprX[sprite] && !freeze) {
+            
+            SET_BIT(spriteSrActive, sprite);
+            active = true;
+            spriteSr[sprite].expFlop = true;
+            spriteSr[sprite].mcFlop = true;
         }
+    }
+    
+    // Run shift register if it is activated
+    if (active && !freeze) {
         
-        // Run shift register if it is activated
-        if (active && !freeze) {
+        // Only proceed if the expansion flipflop is set
+        if (spriteSr[sprite].expFlop) {
             
-            // Only proceed if the expansion flipflop is set
-            if (spriteSr[sprite].expFlop) {
+            // Extract color bits from the shift register
+            if (mCol) {
                 
-                // Extract color bits from the shift register
-                if (mCol) {
-                    
-                    // In multi-color mode, get 2 bits every second pixel
-                    if (spriteSr[sprite].mcFlop) {
-                        spriteSr[sprite].colBits = (spriteSr[sprite].data >> 22) & 0x03;
-                    }
-                    spriteSr[sprite].mcFlop = !spriteSr[sprite].mcFlop;
-                    
-                } else {
-                    
-                    // In single-color mode, get a new bit for each pixel
-                    spriteSr[sprite].colBits = (spriteSr[sprite].data >> 22) & 0x02;
+                // In multi-color mode, get 2 bits every second pixel
+                if (spriteSr[sprite].mcFlop) {
+                    spriteSr[sprite].colBits = (spriteSr[sprite].data >> 22) & 0x03;
                 }
+                spriteSr[sprite].mcFlop = !spriteSr[sprite].mcFlop;
                 
-                // Perform the shift operation
-                spriteSr[sprite].data <<= 1;
+            } else {
                 
-                // Inactivate shift register if everything is pumped out
-                if (!spriteSr[sprite].data && !spriteSr[sprite].colBits) {
-                    active = false;
-                    CLR_BIT(spriteSrActive, sprite);
-                }
+                // In single-color mode, get a new bit for each pixel
+                spriteSr[sprite].colBits = (spriteSr[sprite].data >> 22) & 0x02;
             }
             
-            // Toggle expansion flipflop for horizontally stretched sprites
-            /*
-            if (xExp)
-                spriteSr[sprite].expFlop = !spriteSr[sprite].expFlop;
-            else
-                spriteSr[sprite].expFlop = true;
-             */
-            spriteSr[sprite].expFlop = !spriteSr[sprite].expFlop || !xExp;
-        }
-        
-        // Draw pixel
-        if (active && !hideSprites) {
-            
-            switch (spriteSr[sprite].colBits) {
-                    
-                case 0x01:
-                    setSpritePixel(sprite, pixel, reg.delayed.colors[COLREG_SPR_EX1]);
-                    break;
-                    
-                case 0x02:
-                    setSpritePixel(sprite, pixel, reg.delayed.colors[COLREG_SPR0 + sprite]);
-                    break;
-                    
-                case 0x03:
-                    setSpritePixel(sprite, pixel, reg.delayed.colors[COLREG_SPR_EX2]);
-                    break;
+            // Perform the shift operation
+            spriteSr[sprite].data <<= 1;
+            
+            // Inactivate shift register if everything is pumped out
+            if (!spriteSr[sprite].data && !spriteSr[sprite].colBits) {
+                active = false;
+                CLR_BIT(spriteSrActive, sprite);
             }
         }
+        
+        // Toggle expansion flipflop for horizontally stretched sprites
+        /*
+        if (xExp)
+            spriteSr[sprite].expFlop = !spriteSr[sprite].expFlop;
+        else
+            spriteSr[sprite].expFlop = true;
+         */
+        spriteSr[sprite].expFlop = !spriteSr[sprite].expFlop || !xExp;
     }
+    
+    return active ? spriteSr[sprite].colBits : 0;
 }
 
 void
-VIC::loadColors(u8 mode)
+VIC::loadColors(u8 mode, const u8 *colors)
 {
     u8 character = sr.latchedCharacter;
     u8 color = sr.latchedColor;
@@ -441,7 +680,7 @@ VIC::loadColors(u8 mode)
             
         case STANDARD_TEXT:
             
-            col[0] = reg.delayed.colors[COLREG_BG0];
+            col[0] = colors[COLREG_BG0];
             col[1] = color;
             break;
             
@@ -449,14 +688,14 @@ VIC::loadColors(u8 mode)
             
             if (color & 0x8 /* MC flag */) {
                 
-                col[0] = reg.delayed.colors[COLREG_BG0];
-                col[1] = reg.delayed.colors[COLREG_BG1];
-                col[2] = reg.delayed.colors[COLREG_BG2];
+                col[0] = colors[COLREG_BG0];
+                col[1] = colors[COLREG_BG1];
+                col[2] = colors[COLREG_BG2];
                 col[3] = color & 0x07;
 
             } else {
                 
-                col[0] = reg.delayed.colors[COLREG_BG0];
+                col[0] = colors[COLREG_BG0];
                 col[1] = color;
 
             }
@@ -470,7 +709,7 @@ VIC::loadColors(u8 mode)
             
         case MULTICOLOR_BITMAP:
             
-            col[0] = reg.delayed.colors[COLREG_BG0];
+            col[0] = colors[COLREG_BG0];
             col[1] = character >> 4;
             col[2] = character & 0x0F;
             col[3] = color;
@@ -478,7 +717,7 @@ VIC::loadColors(u8 mode)
             
         case EXTENDED_BACKGROUND_COLOR:
             
-            col[0] = reg.delayed.colors[COLREG_BG0 + (character >> 6)];
+            col[0] = colors[COLREG_BG0 + (character >> 6)];
             col[1] = color;
             break;
             
@@ -505,34 +744,14 @@ VIC::loadColors(u8 mode)
 //
 
 void
-VIC::setSpritePixel(unsigned sprite, unsigned pixel, u8 color)
-{
-    u8 depth = spriteDepth(sprite);
-    u8 source = (1 << sprite);
-    
-    if (depth <= zBuffer[pixel]) {
-        
-        /* "the interesting case is when eg sprite 1 and sprite 0 overlap, and
-         *  sprite 0 has the priority bit set (and sprite 1 has not). in this
-         *  case 10/11 background bits show in front of whole sprite 0."
-         * Test program: VICII/spritePriorities
-         */
-        if (!(pixelSource[pixel] & 0xFF)) {
-            if (isVisibleColumn) COLORIZE(pixel, color);
-            zBuffer[pixel] = depth;
-        }
-    }
-    pixelSource[pixel] |= source;
-}
-
-void
-VIC::expandBorders()
+VIC::expandBorders(u8 *line, bool pal)
 {
-    int color, lastX;
+    u8 color;
+    int lastX;
     unsigned leftPixelPos;
     unsigned rightPixelPos;
     
-    if (c64->vic.isPAL()) {
+    if (pal) {
         leftPixelPos = PAL_LEFT_BORDER_WIDTH - (4*8);
         rightPixelPos = PAL_LEFT_BORDER_WIDTH + PAL_CANVAS_WIDTH + (4*8) - 1;
         lastX = PAL_PIXELS;
@@ -543,24 +762,24 @@ VIC::expandBorders()
     }
     
     // Make picked pixels visible for debugging
-    // pixelBuffer[leftPixelPos + 1] = colors[5];
-    // pixelBuffer[rightPixelPos - 1] = colors[5];
+    // line[leftPixelPos + 1] = colors[5];
+    // line[rightPixelPos - 1] = colors[5];
     
-    color = pixelBuffer[leftPixelPos];
+    color = line[leftPixelPos];
     for (unsigned i = 0; i < leftPixelPos; i++) {
-        pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        line[i] = color;
+        // line[i] = colors[5]; // for debugging
     }
-    color = pixelBuffer[rightPixelPos];
+    color = line[rightPixelPos];
     for (unsigned i = rightPixelPos+1; i < lastX; i++) {
-        pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        line[i] = color;
+        // line[i] = colors[5]; // for debugging
     }
 
     /*
     // Draw grid lines
     for (unsigned i = 0; i < NTSC_PIXELS; i += 10)
-    pixelBuffer[i] = 0xFFFFFFFF;
+    line[i] = 0xFFFFFFFF;
     */
 }
 
@@ -569,8 +788,23 @@ VIC::markLine(u8 color, unsigned start, unsigned end)
 {
     assert (end <= NTSC_PIXELS);
     
-    int rgba = rgbaTable[color];
     for (unsigned i = start; i < end; i++) {
-        pixelBuffer[start + i] = rgba;
+        pixelBuffer[start + i] = color;
     }
 }
+
+//
+// Instantiate the drawing functions for all chip flavours
+//
+
+#define INSTANTIATE_DRAW(model) \
+template void VIC::draw<model>(); \
+template void VIC::draw17<model>(); \
+template void VIC::draw55<model>(); \
+template void VIC::drawSprites<model>();
+
+INSTANTIATE_DRAW(PAL_6569_R3)
+INSTANTIATE_DRAW(PAL_8565)
+INSTANTIATE_DRAW(NTSC_6567_R56A)
+INSTANTIATE_DRAW(NTSC_6567)
+INSTANTIATE_DRAW(NTSC_8562)
@@ -446,6 +446,11 @@ VIC::poke(u16 addr, u8 value)
 {
     assert(addr < 0x40);
  
+    // Draw the deferred part of the rasterline with the old register values
+    if (addr == 0x11 || addr == 0x16 || (addr >= 0x20 && addr <= 0x24)) {
+        leaveQuietLine();
+    }
+    
     dataBusPhi2 = value;
     
     switch(addr) {
@@ -801,7 +806,7 @@ VIC::cAccess()
     }
 }
 
-void
+template <VICModel model> void
 VIC::gAccess()
 {
     u16 addr;
@@ -820,7 +825,7 @@ VIC::gAccess()
          */
  
         // Get address
-        addr = is856x() ? gAccessAddr85x() : gAccessAddr65x();
+        addr = is856x(model) ? gAccessAddr85x() : gAccessAddr65x();
         
         // Fetch
         dataBusPhi1 = memAccess(addr);
@@ -839,7 +844,7 @@ VIC::gAccess()
         
         // Get address. In idle state, g-accesses read from $39FF or $3FFF,
         // depending on the ECM bit.
-        if (is856x()) {
+        if (is856x(model)) {
             addr = GET_BIT(reg.delayed.ctrl1, 6) ? 0x39FF : 0x3FFF;
         } else {
             addr = GET_BIT(reg.current.ctrl1, 6) ? 0x39FF : 0x3FFF;
@@ -853,6 +858,12 @@ VIC::gAccess()
     }
 }
 
+template void VIC::gAccess<PAL_6569_R3>();
+template void VIC::gAccess<PAL_8565>();
+template void VIC::gAccess<NTSC_6567_R56A>();
+template void VIC::gAccess<NTSC_6567>();
+template void VIC::gAccess<NTSC_8562>();
+
 u16
 VIC::gAccessAddr85x()
 {
@@ -985,5 +996,3 @@ void VIC::sFinalize(unsigned sprite)
     assert(sprite < 8);
     isSecondDMAcycle = 0;
 }
-
-
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "C64.h"
+
+static void *
+renderThreadMain(void *thisVIC)
+{
+    ((VIC *)thisVIC)->renderLoop();
+    return NULL;
+}
+
+void
+VIC::setRenderThread(bool enable)
+{
+    if (enable == hasRenderThread()) return;
+    
+    suspend();
+    
+    if (enable) {
+        
+        renderLog = new RenderRecord[renderLogSize];
+        renderHead = renderTail = 0;
+        renderStop = false;
+        renderPending = false;
+        
+        if (pthread_create(&renderThread, NULL, renderThreadMain, this) != 0) {
+            warn("Failed to start the render thread\n");
+            delete[] renderLog;
+            renderLog = NULL;
+        }
+        
+    } else {
+        
+        stopRenderThread();
+    }
+    
+    resume();
+}
+
+void
+VIC::stopRenderThread()
+{
+    assert(renderLog != NULL);
+    
+    // Pending records are drawn before the thread terminates
+    pthread_mutex_lock(&renderLock);
+    renderStop = true;
+    pthread_cond_signal(&renderWork);
+    pthread_mutex_unlock(&renderLock);
+    pthread_join(renderThread, NULL);
+    
+    delete[] renderLog;
+    renderLog = NULL;
+    renderPending = false;
+}
+
+void
+VIC::logQuietLine()
+{
+    assert(renderLog != NULL);
+    
+    // Make sure there is a free record
+    pthread_mutex_lock(&renderLock);
+    while (renderHead - renderTail == renderLogSize) {
+        pthread_cond_wait(&renderDone, &renderLock);
+    }
+    pthread_mutex_unlock(&renderLock);
+    
+    // The render thread doesn't access records beyond renderHead
+    RenderRecord &r = renderLog[renderHead % renderLogSize];
+    r.pixels = pixelBuffer;
+    r.ctrl1 = reg.delayed.ctrl1;
+    r.ctrl2 = reg.delayed.ctrl2;
+    memcpy(r.colors, reg.delayed.colors, sizeof(r.colors));
+    r.pal = isPAL();
+    r.numCycles = numQuietCycles;
+    memcpy(r.cycles, quietCycles, numQuietCycles * sizeof(QuietCycle));
+    
+    quietLine = false;
+    numQuietCycles = 0;
+    renderPending = true;
+    
+    pthread_mutex_lock(&renderLock);
+    renderHead++;
+    pthread_cond_signal(&renderWork);
+    pthread_mutex_unlock(&renderLock);
+}
+
+void
+VIC::waitForRenderer()
+{
+    pthread_mutex_lock(&renderLock);
+    while (renderTail != renderHead) {
+        pthread_cond_wait(&renderDone, &renderLock);
+    }
+    pthread_mutex_unlock(&renderLock);
+    
+    renderPending = false;
+}
+
+void
+VIC::renderLoop()
+{
+    pthread_mutex_lock(&renderLock);
+    
+    while (1) {
+        
+        while (renderTail == renderHead && !renderStop) {
+            pthread_cond_wait(&renderWork, &renderLock);
+        }
+        if (renderTail == renderHead) break;
+        
+        // Draw all pending records without holding the lock
+        u64 head = renderHead;
+        pthread_mutex_unlock(&renderLock);
+        
+        for (u64 i = renderTail; i != head; i++) {
+            
+            RenderRecord &r = renderLog[i % renderLogSize];
+            drawQuietCycles(r.pixels, r.ctrl1, r.ctrl2, r.colors, r.cycles, r.numCycles);
+            expandBorders(r.pixels, r.pal);
+        }
+        
+        pthread_mutex_lock(&renderLock);
+        renderTail = head;
+        pthread_cond_signal(&renderDone);
+    }
+    
+    pthread_mutex_unlock(&renderLock);
+}
@@ -0,0 +1,523 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+/* Headless front end
+ *
+ * This program drives the core emulator without the Cocoa proxy. It runs
+ * entirely inside the calling thread by invoking C64::executeOneFrame() in a
+ * loop and reports the achieved emulation speed. It is meant for profiling
+ * the core and for running unattended emulation jobs on servers. With
+ * --instances, multiple machines are emulated in parallel by a C64Pool.
+ * With --cpu-bench, the CPU runs stand-alone on a fixed instruction mix to
+ * measure the speed of the instruction dispatcher. With --vic-bench, full
+ * frames of all VICII models are timed on a fixed screen. With --trace, all
+ * instructions of the C64 CPU are recorded into a file that survives a crash
+ * of the emulator and can be printed later with --print-trace.
+ */
+
+#include "C64Pool.h"
+#include <getopt.h>
+
+//! @brief    Command line options
+struct Options {
+
+    vector<const char *> roms;
+    vector<u16> breakpoints;
+    vector<u16> watchpoints;
+    const char *disk = NULL;
+    const char *tape = NULL;
+    const char *snapshot = NULL;
+    const char *trace = NULL;
+    const char *printTrace = NULL;
+    u64 frames = 500;
+    u64 cycles = 0;
+    int drives = 1;
+    unsigned skipped = 0;
+    unsigned period = 1;
+    unsigned instances = 0;
+    unsigned workers = 0;
+    bool ntsc = false;
+    bool realtime = false;
+    bool cpuBench = false;
+    bool vicBench = false;
+    bool exact = false;
+    bool fastDrive = false;
+    bool indexed = false;
+    bool renderThread = false;
+};
+
+//! @brief    Number of instructions kept in a trace file
+static const size_t traceCapacity = 1 << 20;
+
+/* Instruction mix of the CPU benchmark (loaded at $1000)
+ *
+ * $1000  SEI               $1016  EOR ($FB),Y       $1023  INX
+ * $1001  CLD               $1018  INC $FD           $1024  BNE $100E
+ * $1002  LDA #$00          $101A  PHA               $1026  JMP $100A
+ * $1004  STA $FB           $101B  JSR $1029         $1029  CMP $FD
+ * $1006  LDA #$20          $101E  PLA               $102B  RTS
+ * $1008  STA $FC           $101F  ASL A
+ * $100A  LDX #$00          $1020  ROR $FD
+ * $100C  LDY #$00          $1022  INY
+ * $100E  LDA $2000,X
+ * $1011  ADC #$01
+ * $1013  STA $2100,X
+ */
+static const u8 benchProgram[] = {
+
+    0x78, 0xD8, 0xA9, 0x00, 0x85, 0xFB, 0xA9, 0x20, 0x85, 0xFC, 0xA2, 0x00,
+    0xA0, 0x00, 0xBD, 0x00, 0x20, 0x69, 0x01, 0x9D, 0x00, 0x21, 0x51, 0xFB,
+    0xE6, 0xFD, 0x48, 0x20, 0x29, 0x10, 0x68, 0x0A, 0x66, 0xFD, 0xC8, 0xE8,
+    0xD0, 0xE8, 0x4C, 0x0A, 0x10, 0xC5, 0xFD, 0x60
+};
+
+/* Screen of the VICII benchmark
+ *
+ * The CPU writes the register values below into $D000 to $D02E and loops
+ * afterwards. The text screen at $0400 shows all 256 characters. The
+ * character set and the data of all eight sprites share a pattern at $2000.
+ * The sprites are spread over the screen, some of them expanded,
+ * multicolored, or behind the foreground.
+ *
+ * $1000  SEI               $1009  LDX #$2E
+ * $1001  LDA #$2F          $100B  LDA $1020,X
+ * $1003  STA $00           $100E  STA $D000,X
+ * $1005  LDA #$37          $1011  DEX
+ * $1007  STA $01           $1012  BPL $100B
+ *                          $1014  JMP $1014
+ */
+static const u8 vicBenchProgram[] = {
+
+    0x78, 0xA9, 0x2F, 0x85, 0x00, 0xA9, 0x37, 0x85, 0x01, 0xA2, 0x2E, 0xBD,
+    0x20, 0x10, 0x9D, 0x00, 0xD0, 0xCA, 0x10, 0xF7, 0x4C, 0x14, 0x10
+};
+
+static const u8 vicBenchRegisters[] = {
+
+    0x20, 0x40, 0x40, 0x50, 0x80, 0x70, 0xB0, 0x88,  // Sprite 0 to 3 (x, y)
+    0xE0, 0xA0, 0x90, 0xB8, 0x40, 0xD0, 0x70, 0xE8,  // Sprite 4 to 7 (x, y)
+    0x40, 0x1B, 0x00, 0x00, 0x00, 0xFF, 0x08, 0x33,  // $D010 to $D017
+    0x18, 0xFF, 0x00, 0x0C, 0x55, 0xA5, 0x00, 0x00,  // $D018 to $D01F
+    0x0E, 0x06, 0x01, 0x02, 0x03, 0x04, 0x05, 0x07,  // $D020 to $D027
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0F         // $D028 to $D02E
+};
+
+static void
+usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [options]\n\n", name);
+    fprintf(stderr, "  -r, --rom <file>       Load a Basic, Character, Kernal or VC1541 Rom\n");
+    fprintf(stderr, "  -d, --disk <file>      Insert a disk or archive into drive 8\n");
+    fprintf(stderr, "  -t, --tape <file>      Insert a tape into the datasette\n");
+    fprintf(stderr, "  -s, --snapshot <file>  Restore a snapshot before running\n");
+    fprintf(stderr, "  -f, --frames <n>       Number of frames to emulate (default: 500)\n");
+    fprintf(stderr, "  -c, --cycles <n>       Number of cycles to emulate (overrides -f)\n");
+    fprintf(stderr, "  -D, --drives <n>       Number of powered on drives (0, 1, or 2, default: 1)\n");
+    fprintf(stderr, "  -k, --skip <n>/<m>     Skip drawing n out of m frames\n");
+    fprintf(stderr, "  -I, --indexed          Output color numbers instead of RGBA pixels\n");
+    fprintf(stderr, "  -S, --render-thread    Draw rasterlines on a separate thread\n");
+    fprintf(stderr, "  -i, --instances <n>    Run n machines in parallel in a thread pool\n");
+    fprintf(stderr, "  -w, --workers <n>      Number of pool threads (default: all cores)\n");
+    fprintf(stderr, "  -n, --ntsc             Emulate an NTSC machine instead of a PAL machine\n");
+    fprintf(stderr, "  -R, --realtime         Synchronize with the real-time clock\n");
+    fprintf(stderr, "  -x, --exact            Disable idle loop skipping\n");
+    fprintf(stderr, "  -F, --fast-drive       Run quiet drive instructions in one go (not cycle-exact)\n");
+    fprintf(stderr, "  -b, --cpu-bench        Run the CPU alone on a fixed instruction mix\n");
+    fprintf(stderr, "                         (default: 100000000 cycles)\n");
+    fprintf(stderr, "  -v, --vic-bench        Time full frames of all VICII models\n");
+    fprintf(stderr, "  -B, --break <addr>     Stop when the CPU reaches a hex address\n");
+    fprintf(stderr, "  -W, --watch <addr>     Stop when the CPU accesses a hex address\n");
+    fprintf(stderr, "  -T, --trace <file>     Record the latest %zu CPU instructions\n", traceCapacity);
+    fprintf(stderr, "  -P, --print-trace <file> Print a recorded trace and exit\n");
+    fprintf(stderr, "  -h, --help             Print this message\n");
+}
+
+static bool
+parseOptions(int argc, char *argv[], Options &opt)
+{
+    static struct option longOptions[] = {
+
+        { "rom",      required_argument, NULL, 'r' },
+        { "disk",     required_argument, NULL, 'd' },
+        { "tape",     required_argument, NULL, 't' },
+        { "snapshot", required_argument, NULL, 's' },
+        { "frames",   required_argument, NULL, 'f' },
+        { "cycles",   required_argument, NULL, 'c' },
+        { "drives",   required_argument, NULL, 'D' },
+        { "skip",     required_argument, NULL, 'k' },
+        { "indexed",  no_argument,       NULL, 'I' },
+        { "render-thread", no_argument,  NULL, 'S' },
+        { "instances", required_argument, NULL, 'i' },
+        { "workers",  required_argument, NULL, 'w' },
+        { "ntsc",     no_argument,       NULL, 'n' },
+        { "realtime", no_argument,       NULL, 'R' },
+        { "exact",    no_argument,       NULL, 'x' },
+        { "fast-drive", no_argument,     NULL, 'F' },
+        { "cpu-bench", no_argument,      NULL, 'b' },
+        { "vic-bench", no_argument,      NULL, 'v' },
+        { "break",    required_argument, NULL, 'B' },
+        { "watch",    required_argument, NULL, 'W' },
+        { "trace",    required_argument, NULL, 'T' },
+        { "print-trace", required_argument, NULL, 'P' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL,       0,                 NULL, 0   }};
+
+    int c;
+    while ((c = getopt_long(argc, argv, "r:d:t:s:f:c:D:k:ISi:w:nRxFbvB:W:T:P:h", longOptions, NULL)) != -1) {
+
+        switch (c) {
+
+            case 'r': opt.roms.push_back(optarg); break;
+            case 'd': opt.disk = optarg; break;
+            case 't': opt.tape = optarg; break;
+            case 's': opt.snapshot = optarg; break;
+            case 'f': opt.frames = strtoull(optarg, NULL, 10); break;
+            case 'c': opt.cycles = strtoull(optarg, NULL, 10); break;
+            case 'D': opt.drives = atoi(optarg); break;
+            case 'k':
+                if (sscanf(optarg, "%u/%u", &opt.skipped, &opt.period) != 2) return false;
+                break;
+            case 'I': opt.indexed = true; break;
+            case 'S': opt.renderThread = true; break;
+            case 'i': opt.instances = atoi(optarg); break;
+            case 'w': opt.workers = atoi(optarg); break;
+            case 'n': opt.ntsc = true; break;
+            case 'R': opt.realtime = true; break;
+            case 'x': opt.exact = true; break;
+            case 'F': opt.fastDrive = true; break;
+            case 'b': opt.cpuBench = true; break;
+            case 'v': opt.vicBench = true; break;
+            case 'B': opt.breakpoints.push_back((u16)strtoul(optarg, NULL, 16)); break;
+            case 'W': opt.watchpoints.push_back((u16)strtoul(optarg, NULL, 16)); break;
+            case 'T': opt.trace = optarg; break;
+            case 'P': opt.printTrace = optarg; break;
+            default: return false;
+        }
+    }
+    return
+    optind == argc &&
+    opt.drives >= 0 && opt.drives <= 2 &&
+    opt.skipped < opt.period &&
+    !(opt.instances && opt.realtime) &&
+    !(opt.instances && opt.trace);
+}
+
+static void
+setupGuards(C64 &c64, Options &opt)
+{
+    for (auto addr : opt.breakpoints) {
+        c64.cpu.setHardBreakpoint(addr);
+    }
+    for (auto addr : opt.watchpoints) {
+        c64.cpu.breakpoints.setWatchpoint(addr, WATCH_READ | WATCH_WRITE);
+    }
+}
+
+static bool
+setup(C64 &c64, Options &opt)
+{
+    c64.setModel(opt.ntsc ? C64_NTSC : C64_PAL);
+
+    for (auto rom : opt.roms) {
+        if (!c64.loadRom(rom)) return false;
+    }
+    if (!c64.isRunnable()) {
+        fprintf(stderr, "Warning: Rom images are missing\n");
+    }
+
+    if (opt.snapshot) {
+        Snapshot *snapshot = Snapshot::makeWithFile(opt.snapshot);
+        if (!snapshot) {
+            fprintf(stderr, "Failed to read snapshot %s\n", opt.snapshot);
+            return false;
+        }
+        bool loaded = c64.loadFromSnapshotUnsafe(snapshot);
+        delete snapshot;
+        if (!loaded) {
+            fprintf(stderr, "Snapshot %s is incomplete\n", opt.snapshot);
+            return false;
+        }
+    }
+
+    if (opt.drives >= 1) c64.drive1.powerOn(); else c64.drive1.powerOff();
+    if (opt.drives >= 2) c64.drive2.powerOn(); else c64.drive2.powerOff();
+    c64.drive1.setFastPath(opt.fastDrive);
+    c64.drive2.setFastPath(opt.fastDrive);
+    c64.cpu.setIdleSkipping(!opt.exact);
+    setupGuards(c64, opt);
+
+    if (opt.trace) {
+        if (!c64.cpu.setTraceFile(opt.trace, traceCapacity)) {
+            fprintf(stderr, "Failed to create trace file %s\n", opt.trace);
+            return false;
+        }
+        c64.cpu.startTracing();
+    }
+
+    if (opt.disk) {
+        AnyArchive *archive = AnyArchive::makeWithFile(opt.disk);
+        if (!archive) {
+            fprintf(stderr, "Failed to read disk %s\n", opt.disk);
+            return false;
+        }
+        c64.drive1.insertDisk(archive);
+        delete archive;
+    }
+
+    if (opt.tape) {
+        TAPFile *tape = TAPFile::makeWithFile(opt.tape);
+        if (!tape || !c64.datasette.insertTape(tape)) {
+            fprintf(stderr, "Failed to read tape %s\n", opt.tape);
+            return false;
+        }
+        delete tape;
+    }
+
+    c64.setFrameSkip(opt.skipped, opt.period);
+    c64.vic.setScreenFormat(opt.indexed ? SCREEN_INDEXED : SCREEN_RGBA);
+    c64.vic.setRenderThread(opt.renderThread);
+    c64.setAlwaysWarp(!opt.realtime);
+    c64.restartTimer();
+    return true;
+}
+
+static void
+reportHalt(C64 *c64)
+{
+    fprintf(stderr, "CPU halted at $%04X in cycle %llu (error state %d)\n",
+            c64->cpu.getPC(), (unsigned long long)c64->cpu.cycle,
+            c64->cpu.getErrorState());
+}
+
+static void
+jobCompleted(C64 *c64, bool success, void *data)
+{
+    if (!success) {
+        fprintf(stderr, "Instance %p stopped at cycle %llu\n",
+                (void *)c64, (unsigned long long)c64->cpu.cycle);
+        *(bool *)data = false;
+    }
+}
+
+static int
+runPool(Options &opt)
+{
+    vector<C64 *> instances;
+    bool success = true;
+    
+    for (unsigned i = 0; i < opt.instances; i++) {
+        C64 *c64 = new C64();
+        instances.push_back(c64);
+        if (!setup(*c64, opt)) {
+            for (auto c : instances) delete c;
+            return 1;
+        }
+    }
+    
+    C64Pool pool(opt.workers);
+    u64 budget = opt.cycles ? opt.cycles : opt.frames * instances[0]->vic.getCyclesPerFrame();
+    u64 cycles = 0;
+    u64 frames = 0;
+    
+    for (auto c64 : instances) {
+        cycles -= c64->cpu.cycle;
+        frames -= c64->frame;
+    }
+    
+    u64 start = monotonicNanos();
+    for (auto c64 : instances) {
+        pool.submit(c64, budget, jobCompleted, &success);
+    }
+    pool.wait();
+    double elapsed = (monotonicNanos() - start) / 1000000000.0;
+    
+    for (auto c64 : instances) {
+        cycles += c64->cpu.cycle;
+        frames += c64->frame;
+        delete c64;
+    }
+    
+    printf("Emulated %u instances on %u threads in %.3f sec\n",
+           opt.instances, pool.numWorkers(), elapsed);
+    printf("%llu frames (%llu cycles) in total\n",
+           (unsigned long long)frames, (unsigned long long)cycles);
+    printf("%.1f frames per second, %.2f MHz\n",
+           frames / elapsed, cycles / elapsed / 1000000.0);
+    
+    return success ? 0 : 2;
+}
+
+static int
+runCpuBench(Options &opt)
+{
+    C64 *c64 = new C64();
+    u64 cycles = opt.cycles ? opt.cycles : 100000000;
+    bool success = true;
+    
+    memcpy(c64->mem.ram + 0x1000, benchProgram, sizeof(benchProgram));
+    c64->cpu.jumpToAddress(0x1000);
+    setupGuards(*c64, opt);
+    
+    u64 start = monotonicNanos();
+    u64 executed = 0;
+    while (success && executed < cycles) {
+        success = c64->cpu.executeCycle<C64Memory>();
+        executed++;
+    }
+    double elapsed = (monotonicNanos() - start) / 1000000000.0;
+    cycles = executed;
+    
+    if (!success) reportHalt(c64);
+    printf("Executed %llu CPU cycles in %.3f sec\n",
+           (unsigned long long)cycles, elapsed);
+    printf("%.2f MHz\n", cycles / elapsed / 1000000.0);
+    
+    delete c64;
+    return success ? 0 : 2;
+}
+
+static int
+runVicBench(Options &opt)
+{
+    static const struct { VICModel model; const char *name; } models[] = {
+        
+        { PAL_6569_R1,    "MOS 6569 R1 (PAL)" },
+        { PAL_6569_R3,    "MOS 6569 R3 (PAL)" },
+        { PAL_8565,       "MOS 8565 (PAL)" },
+        { NTSC_6567_R56A, "MOS 6567 R56A (NTSC)" },
+        { NTSC_6567,      "MOS 6567 R8 (NTSC)" },
+        { NTSC_8562,      "MOS 8562 (NTSC)" }
+    };
+    bool success = true;
+    
+    for (auto &m : models) {
+        
+        C64 *c64 = new C64();
+        c64->vic.setModel(m.model);
+        c64->vic.setScreenFormat(opt.indexed ? SCREEN_INDEXED : SCREEN_RGBA);
+        c64->vic.setRenderThread(opt.renderThread);
+        c64->drive1.powerOff();
+        c64->drive2.powerOff();
+        c64->setAlwaysWarp(true);
+        
+        memcpy(c64->mem.ram + 0x1000, vicBenchProgram, sizeof(vicBenchProgram));
+        memcpy(c64->mem.ram + 0x1020, vicBenchRegisters, sizeof(vicBenchRegisters));
+        for (unsigned i = 0; i < 1000; i++) c64->mem.ram[0x0400 + i] = (u8)i;
+        for (unsigned i = 0; i < 8; i++) c64->mem.ram[0x07F8 + i] = 0x80;
+        for (unsigned i = 0; i < 2048; i++) c64->mem.ram[0x2000 + i] = (u8)(0x3C ^ (i * 7));
+        c64->cpu.jumpToAddress(0x1000);
+        
+        // Let the CPU set up the registers before timing starts
+        for (unsigned i = 0; success && i < 2; i++) {
+            success = c64->executeOneFrame();
+        }
+        
+        u64 start = monotonicNanos();
+        u64 frames = 0;
+        while (success && frames < opt.frames) {
+            success = c64->executeOneFrame();
+            frames++;
+        }
+        double elapsed = (monotonicNanos() - start) / 1000.0;
+        
+        if (!success) reportHalt(c64);
+        printf("%-22s %3u cycles per line  %8.1f usec per frame\n",
+               m.name, c64->vic.getCyclesPerRasterline(), elapsed / frames);
+        
+        delete c64;
+    }
+    
+    return success ? 0 : 2;
+}
+
+static int
+runPrintTrace(Options &opt)
+{
+    TraceBuffer trace;
+    
+    if (!trace.load(opt.printTrace)) {
+        fprintf(stderr, "Failed to read trace file %s\n", opt.printTrace);
+        return 1;
+    }
+    
+    // The CPU is only needed for its disassembler
+    C64 *c64 = new C64();
+    
+    for (u64 i = trace.first(); i < trace.appended(); i++) {
+        
+        RecordedInstruction rec = trace.get(i);
+        DisassembledInstruction instr = c64->cpu.disassemble(rec, true);
+        
+        printf("%12llu  %s: %s %s %s   %s %s %s %s %s   %s\n",
+               (unsigned long long)rec.cycle, instr.pc,
+               instr.byte1, instr.byte2, instr.byte3,
+               instr.a, instr.x, instr.y, instr.sp, instr.flags,
+               instr.command);
+    }
+    
+    delete c64;
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    Options opt;
+
+    if (!parseOptions(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+    
+    if (opt.printTrace) {
+        return runPrintTrace(opt);
+    }
+    if (opt.cpuBench) {
+        return runCpuBench(opt);
+    }
+    if (opt.vicBench) {
+        return runVicBench(opt);
+    }
+    if (opt.instances) {
+        return runPool(opt);
+    }
+
+    C64 *c64 = new C64();
+    if (!setup(*c64, opt)) {
+        delete c64;
+        return 1;
+    }
+
+    u64 cycles = c64->cpu.cycle;
+    u64 start = monotonicNanos();
+    u64 frames = c64->frame;
+    bool success = true;
+
+    if (opt.cycles) {
+        success = c64->executeCycles(opt.cycles);
+    } else {
+        for (u64 i = 0; success && i < opt.frames; i++) {
+            success = c64->executeOneFrame();
+        }
+    }
+
+    double elapsed = (monotonicNanos() - start) / 1000000000.0;
+    cycles = c64->cpu.cycle - cycles;
+    frames = c64->frame - frames;
+
+    if (!success) reportHalt(c64);
+
+    printf("Emulated %llu frames (%llu cycles) in %.3f sec\n",
+           (unsigned long long)frames, (unsigned long long)cycles, elapsed);
+    printf("%.1f frames per second, %.2f MHz\n",
+           frames / elapsed, cycles / elapsed / 1000000.0);
+
+    delete c64;
+    return success ? 0 : 2;
+}
@@ -172,6 +172,9 @@ struct AnyC64FileWrapper;
 
 - (void) deleteAutoSnapshot:(NSInteger)nr;
 - (void) deleteUserSnapshot:(NSInteger)nr;
+- (NSInteger) rewindBudget;
+- (void) setRewindBudget:(NSInteger)bytes;
+- (BOOL) seekToFrame:(NSInteger)frame;
 
 // Handling ROMs
 - (BOOL) isBasicRom:(NSURL *)url;
@@ -215,6 +218,8 @@ struct AnyC64FileWrapper;
 
 - (BOOL) tracing;
 - (void) setTracing:(BOOL)b;
+- (BOOL) idleSkipping;
+- (void) setIdleSkipping:(BOOL)b;
 
 - (UInt64) cycle;
 - (u16) pc;
@@ -325,6 +330,8 @@ struct AnyC64FileWrapper;
 - (BOOL) isPAL;
 
 - (void *) screenBuffer;
+- (UInt64) screenBufferSeqNr;
+- (UInt64) latestSeqNr;
 - (NSColor *) color:(NSInteger)nr;
 - (UInt32) rgbaColor:(NSInteger)nr palette:(VICPalette)palette;
 - (double)brightness;
@@ -582,6 +589,8 @@ struct AnyC64FileWrapper;
 - (BOOL) hasWriteProtectedDisk;
 - (BOOL) sendSoundMessages;
 - (void) setSendSoundMessages:(BOOL)b;
+- (BOOL) fastPath;
+- (void) setFastPath:(BOOL)b;
 
 - (Halftrack) halftrack;
 - (void) setTrack:(Track)t;
@@ -62,6 +62,14 @@ struct AnyC64FileWrapper { AnyC64File *file; };
 {
     b ? wrapper->cpu->startTracing() : wrapper->cpu->stopTracing();
 }
+- (BOOL) idleSkipping
+{
+    return wrapper->cpu->idleSkippingEnabled();
+}
+- (void) setIdleSkipping:(BOOL)b
+{
+    wrapper->cpu->setIdleSkipping(b);
+}
 - (UInt64) cycle
 {
     return wrapper->cpu->cycle;
@@ -376,6 +384,14 @@ struct AnyC64FileWrapper { AnyC64File *file; };
 {
     return wrapper->vic->screenBuffer();
 }
+- (UInt64) screenBufferSeqNr
+{
+    return wrapper->vic->screenBufferSeqNr();
+}
+- (UInt64) latestSeqNr
+{
+    return wrapper->vic->latestSeqNr();
+}
 - (NSColor *) color:(NSInteger)nr
 {
     assert (0 <= nr && nr < 16);
@@ -1183,6 +1199,14 @@ struct AnyC64FileWrapper { AnyC64File *file; };
 {
     wrapper->drive->setSendSoundMessages(b);
 }
+- (BOOL) fastPath
+{
+    return wrapper->drive->fastPathEnabled();
+}
+- (void) setFastPath:(BOOL)b
+{
+    wrapper->drive->setFastPath(b);
+}
 - (Halftrack) halftrack
 {
     return wrapper->drive->getHalftrack();
@@ -1603,13 +1627,15 @@ struct AnyC64FileWrapper { AnyC64File *file; };
 }
 - (NSData *)autoSnapshotData:(NSInteger)nr {
     Snapshot *snapshot = wrapper->c64->autoSnapshot((unsigned)nr);
-    return [NSData dataWithBytes: (void *)snapshot->getHeader()
-                          length: snapshot->sizeOnDisk()];
+    NSMutableData *data = [NSMutableData dataWithLength: snapshot->sizeOnDisk()];
+    snapshot->writeToBuffer((u8 *)[data mutableBytes]);
+    return data;
 }
 - (NSData *)userSnapshotData:(NSInteger)nr {
     Snapshot *snapshot = wrapper->c64->userSnapshot((unsigned)nr);
-    return [NSData dataWithBytes: (void *)snapshot->getHeader()
-                          length: snapshot->sizeOnDisk()];
+    NSMutableData *data = [NSMutableData dataWithLength: snapshot->sizeOnDisk()];
+    snapshot->writeToBuffer((u8 *)[data mutableBytes]);
+    return data;
 }
 - (unsigned char *)autoSnapshotImageData:(NSInteger)nr
 {
@@ -1649,6 +1675,18 @@ struct AnyC64FileWrapper { AnyC64File *file; };
 {
     wrapper->c64->deleteUserSnapshot((unsigned)nr);
 }
+- (NSInteger)rewindBudget
+{
+    return wrapper->c64->getRewindBudget();
+}
+- (void)setRewindBudget:(NSInteger)bytes
+{
+    wrapper->c64->setRewindBudget((size_t)bytes);
+}
+- (BOOL)seekToFrame:(NSInteger)frame
+{
+    return wrapper->c64->seekToFrame((u64)frame);
+}
 
 // Handling ROMs
 - (BOOL) isBasicRom:(NSURL *)url
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "SelfCheck.h"
+
+/* The CPU executes ADC #op and SBC #op for all combinations of the
+ * accumulator, the operand, and the carry bit. The results come from the
+ * lookup tables and are compared against the digit-by-digit algorithms the
+ * tables were generated with. Hence, the check covers the table layout, the
+ * table selection by instruction and carry, and the flag handling.
+ */
+bool
+checkDecimalMode()
+{
+    C64 *c64 = new C64();
+    CPU &cpu = c64->cpu;
+    unsigned errors = 0;
+    
+    for (unsigned i = 0; i < 4 * 65536; i++) {
+        
+        bool subtract = i & 0x20000;
+        u8 carry = (i >> 16) & 1;
+        u8 a = (i >> 8) & 0xFF;
+        u8 op = i & 0xFF;
+        
+        c64->mem.ram[0x1000] = subtract ? 0xE9 : 0x69;
+        c64->mem.ram[0x1001] = op;
+        cpu.regA = a;
+        cpu.setD(1);
+        cpu.setC(carry);
+        cpu.jumpToAddress(0x1000);
+        do {
+            cpu.executeOneCycle<C64Memory>();
+        } while (!cpu.inFetchPhase());
+        
+        u16 expected = subtract ? CPU::sbcDecimal(a, op, carry) : CPU::adcDecimal(a, op, carry);
+        u8 flags = cpu.getN() | cpu.getV() | cpu.getZ() | cpu.getC();
+        
+        if (cpu.regA != LO_BYTE(expected) || flags != HI_BYTE(expected)) {
+            fprintf(stderr, "%s $%02X, $%02X, C = %d: A = $%02X, flags $%02X (expected $%02X, $%02X)\n",
+                    subtract ? "SBC" : "ADC", a, op, carry,
+                    cpu.regA, flags, LO_BYTE(expected), HI_BYTE(expected));
+            errors++;
+        }
+    }
+    
+    delete c64;
+    
+    printf("Decimal mode: %u of 262144 ADC/SBC results differ\n", errors);
+    return errors == 0;
+}
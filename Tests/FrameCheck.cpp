@@ -0,0 +1,171 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "SelfCheck.h"
+
+/* Program of the frame check (loaded at $1000)
+ *
+ * The program writes frameCheckRegisters into $D000 to $D02E
+ * and runs a loop of 15 bytes afterwards. Depending on the scenario, the
+ * loop writes color, scroll, mode, bank or sprite registers in the middle
+ * of rasterlines or leaves the registers alone.
+ *
+ * $1000  SEI               $1009  LDX #$2E
+ * $1001  LDA #$2F          $100B  LDA $1040,X
+ * $1003  STA $00           $100E  STA $D000,X
+ * $1005  LDA #$35          $1011  DEX
+ * $1007  STA $01           $1012  BPL $100B
+ *                          $1014  (loop of the scenario)
+ *                          $1023  JMP $1014
+ */
+static const u8 frameCheckProgram[] = {
+
+    0x78, 0xA9, 0x2F, 0x85, 0x00, 0xA9, 0x35, 0x85, 0x01, 0xA2, 0x2E, 0xBD,
+    0x40, 0x10, 0x9D, 0x00, 0xD0, 0xCA, 0x10, 0xF7
+};
+
+static const u8 frameCheckLoops[][15] = {
+    
+    // No register writes
+    { 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA,
+      0xEA, 0xEA, 0xEA },
+    
+    // INC $D021, INC $D016, INC $D020, INC $D022, INC $D023
+    { 0xEE, 0x21, 0xD0, 0xEE, 0x16, 0xD0, 0xEE, 0x20, 0xD0, 0xEE, 0x22, 0xD0,
+      0xEE, 0x23, 0xD0 },
+    
+    // LDA $D012, AND #$67, ORA #$10, STA $D011, INC $D024, NOP, NOP
+    { 0xAD, 0x12, 0xD0, 0x29, 0x67, 0x09, 0x10, 0x8D, 0x11, 0xD0, 0xEE, 0x24,
+      0xD0, 0xEA, 0xEA },
+    
+    // INC $DD00, INC $D018, INC $0400, INC $D019, NOP, NOP, NOP
+    { 0xEE, 0x00, 0xDD, 0xEE, 0x18, 0xD0, 0xEE, 0x00, 0x04, 0xEE, 0x19, 0xD0,
+      0xEA, 0xEA, 0xEA },
+    
+    // INC $D01C, INC $D01D, INC $D01B, INC $D027, INC $D000
+    { 0xEE, 0x1C, 0xD0, 0xEE, 0x1D, 0xD0, 0xEE, 0x1B, 0xD0, 0xEE, 0x27, 0xD0,
+      0xEE, 0x00, 0xD0 },
+    
+    // INC $D025, INC $D017, LDA $D01E, LDA $D01F, INC $D002
+    { 0xEE, 0x25, 0xD0, 0xEE, 0x17, 0xD0, 0xAD, 0x1E, 0xD0, 0xAD, 0x1F, 0xD0,
+      0xEE, 0x02, 0xD0 }
+};
+
+
+/* Register values of the frame check (loaded at $1040)
+ *
+ * The sprites are spread over the screen, some of them expanded,
+ * multicolored, or behind the foreground. This is the screen of the VICII
+ * benchmark of the headless front end.
+ */
+static const u8 frameCheckRegisters[] = {
+
+    0x20, 0x40, 0x40, 0x50, 0x80, 0x70, 0xB0, 0x88,  // Sprite 0 to 3 (x, y)
+    0xE0, 0xA0, 0x90, 0xB8, 0x40, 0xD0, 0x70, 0xE8,  // Sprite 4 to 7 (x, y)
+    0x40, 0x1B, 0x00, 0x00, 0x00, 0xFF, 0x08, 0x33,  // $D010 to $D017
+    0x18, 0xFF, 0x00, 0x0C, 0x55, 0xA5, 0x00, 0x00,  // $D018 to $D01F
+    0x0E, 0x06, 0x01, 0x02, 0x03, 0x04, 0x05, 0x07,  // $D020 to $D027
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0F         // $D028 to $D02E
+};
+
+
+/*! @brief    Runs frameCheckProgram and returns a digest of all frames
+ *  @details  Between two frames, the display mode, the video matrix, the
+ *            character base and a color register change at random.
+ */
+static u64
+runFrameScenario(VICModel model, unsigned loop, bool renderThread)
+{
+    C64 *c64 = makeCheckMachine(model);
+    c64->vic.setRenderThread(renderThread);
+    CheckRandom random(1 + loop);
+    
+    for (unsigned i = 0; i < 0x10000; i++) {
+        c64->mem.ram[i] = (u8)random.next();
+    }
+    for (unsigned i = 0; i < 0x400; i++) {
+        c64->mem.colorRam[i] = random.next() & 0x0F;
+    }
+    memcpy(c64->mem.ram + 0x1000, frameCheckProgram, sizeof(frameCheckProgram));
+    memcpy(c64->mem.ram + 0x1014, frameCheckLoops[loop], 15);
+    memcpy(c64->mem.ram + 0x1023, "\x4C\x14\x10", 3);
+    memcpy(c64->mem.ram + 0x1040, frameCheckRegisters, sizeof(frameCheckRegisters));
+    c64->cpu.jumpToAddress(0x1000);
+    
+    // Let the program bank in the I/O area, then make the bank bits outputs
+    c64->executeOneFrame();
+    c64->mem.poke(0xDD02, 0x03);
+    
+    u64 digest = 0;
+    for (unsigned frame = 0; frame < 150; frame++) {
+        
+        if (loop == 0 || frame % 3 == 0) {
+            
+            u16 random1 = random.next(), random2 = random.next();
+            u8 r1 = LO_BYTE(random1), r2 = HI_BYTE(random1);
+            u8 r3 = LO_BYTE(random2), r4 = HI_BYTE(random2);
+            
+            c64->mem.poke(0xD011, (r1 & 0x6F) | 0x10);
+            c64->mem.poke(0xD016, r2 & 0x1F);
+            c64->mem.poke(0xD018, r3);
+            c64->mem.poke(0xD020 + r4 % 5, r4 >> 3);
+            if (frame % 7 == 0) {
+                c64->mem.poke(0xD015, loop >= 4 ? 0xFF : r1 & r3);
+            }
+        }
+        c64->executeOneFrame();
+        digest = foldDigest(digest, fnv_1a_64(c64->vic.stableIndexBuffer(),
+                                              PAL_RASTERLINES * NTSC_PIXELS));
+    }
+    
+    delete c64;
+    return digest;
+}
+
+bool
+checkFrames()
+{
+    /* Each loop of frameCheckLoops runs on two VICII models. The digests were
+     * recorded before quiet rasterlines were drawn in one go. All scenarios
+     * run with and without the render thread.
+     */
+    static const struct { VICModel model; unsigned loop; u64 digest; } scenarios[] = {
+        
+        { PAL_6569_R3,    0, 0x7fd4f470a91e7038 },
+        { NTSC_6567,      0, 0x42f4ee974d821084 },
+        { PAL_6569_R1,    1, 0xedf80ad37e1ffef2 },
+        { NTSC_6567_R56A, 1, 0x6e4b9d3f6e34e617 },
+        { PAL_8565,       2, 0x6c3ba674ead2bb60 },
+        { NTSC_8562,      2, 0x128f0a63f38bd288 },
+        { NTSC_6567,      3, 0x34e82af2364bc418 },
+        { PAL_6569_R3,    3, 0x2a1b8c1351a85cac },
+        { NTSC_6567_R56A, 4, 0x720cf1320bbbf55d },
+        { PAL_6569_R1,    4, 0xbf9f306f3e79e5e7 },
+        { NTSC_8562,      5, 0x0feb60b3d91531d7 },
+        { PAL_8565,       5, 0x256a96b12df01908 }
+    };
+    unsigned count = sizeof(scenarios) / sizeof(scenarios[0]);
+    unsigned errors = 0;
+    
+    for (unsigned i = 0; i < 2 * count; i++) {
+        
+        auto &s = scenarios[i % count];
+        bool renderThread = i >= count;
+        u64 digest = runFrameScenario(s.model, s.loop, renderThread);
+        if (digest != s.digest) {
+            fprintf(stderr, "Scenario %u%s: digest %016llx, expected %016llx\n",
+                    i % count, renderThread ? " (render thread)" : "",
+                    (unsigned long long)digest, (unsigned long long)s.digest);
+            errors++;
+        }
+    }
+    
+    printf("Frames: %u of %u scenarios differ\n", errors, 2 * count);
+    return errors == 0;
+}
@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "SelfCheck.h"
+
+/* Interrupt program of the IRQ timing check (loaded at $1000)
+ *
+ * The program banks out the Kernal, installs its own IRQ and NMI vectors
+ * and reads its configuration from zero page: the raster line ($F0), the
+ * VICII interrupt mask ($F1), the period ($F2/$F3) and the interrupt mask
+ * ($F4) of CIA1 timer A, and the same for CIA2 timer A ($F5 to $F7). The
+ * main loop mixes page crossings, taken branches and short SEI/CLI windows.
+ * The handlers log the timer and raster values they see on entry into
+ * $2000 to $26FF, so any shift in interrupt timing changes the memory.
+ *
+ * $1000  SEI               $1044  LDA $F2           $1083  PHA (IRQ)
+ * $1001  CLD               $1046  STA $DC04         $1084  TXA
+ * $1002  LDA #$2F          $1049  LDA $F3           $1085  PHA
+ * $1004  STA $00           $104B  STA $DC05         $1086  LDX $FA
+ * $1006  LDA #$35          $104E  LDA $F4           $1088  LDA $DC04
+ * $1008  STA $01           $1050  STA $DC0D         $108B  STA $2000,X
+ * $100A  LDX #$FF          $1053  LDA $F5           $108E  LDA $D012
+ * $100C  TXS               $1055  STA $DD04         $1091  STA $2100,X
+ * $100D  LDA #$83          $1058  LDA $F6           $1094  LDA $DC0D
+ * $100F  STA $FFFE         $105A  STA $DD05         $1097  STA $2200,X
+ * $1012  LDA #$10          $105D  LDA $F7           $109A  LDA $D019
+ * $1014  STA $FFFF         $105F  STA $DD0D         $109D  STA $2300,X
+ * $1017  LDA #$A9          $1062  LDA #$11          $10A0  STA $D019
+ * $1019  STA $FFFA         $1064  STA $DC0E         $10A3  INC $FA
+ * $101C  LDA #$10          $1067  STA $DD0E         $10A5  PLA
+ * $101E  STA $FFFB         $106A  CLI               $10A6  TAX
+ * $1021  LDA #$00          $106B  INC $FC           $10A7  PLA
+ * $1023  STA $FA           $106D  LDA $FC           $10A8  RTI
+ * $1025  STA $FB           $106F  AND #$07          $10A9  PHA (NMI)
+ * $1027  LDA #$7F          $1071  BNE $1076         $10AA  TXA
+ * $1029  STA $DC0D         $1073  SEI               $10AB  PHA
+ * $102C  STA $DD0D         $1074  NOP               $10AC  LDX $FB
+ * $102F  LDA $DC0D         $1075  CLI               $10AE  LDA $DD04
+ * $1032  LDA $DD0D         $1076  LDX $FC           $10B1  STA $2400,X
+ * $1035  LDA $F0           $1078  LDA $10F0,X       $10B4  LDA $DC04
+ * $1037  STA $D012         $107B  LDY #$03          $10B7  STA $2500,X
+ * $103A  LDA #$1B          $107D  DEY               $10BA  LDA $DD0D
+ * $103C  STA $D011         $107E  BNE $107D         $10BD  STA $2600,X
+ * $103F  LDA $F1           $1080  JMP $106B         $10C0  INC $FB
+ * $1041  STA $D01A                                  $10C2  PLA
+ *                                                   $10C3  TAX
+ *                                                   $10C4  PLA
+ *                                                   $10C5  RTI
+ */
+static const u8 irqCheckProgram[] = {
+
+    0x78, 0xD8, 0xA9, 0x2F, 0x85, 0x00, 0xA9, 0x35, 0x85, 0x01, 0xA2, 0xFF,
+    0x9A, 0xA9, 0x83, 0x8D, 0xFE, 0xFF, 0xA9, 0x10, 0x8D, 0xFF, 0xFF, 0xA9,
+    0xA9, 0x8D, 0xFA, 0xFF, 0xA9, 0x10, 0x8D, 0xFB, 0xFF, 0xA9, 0x00, 0x85,
+    0xFA, 0x85, 0xFB, 0xA9, 0x7F, 0x8D, 0x0D, 0xDC, 0x8D, 0x0D, 0xDD, 0xAD,
+    0x0D, 0xDC, 0xAD, 0x0D, 0xDD, 0xA5, 0xF0, 0x8D, 0x12, 0xD0, 0xA9, 0x1B,
+    0x8D, 0x11, 0xD0, 0xA5, 0xF1, 0x8D, 0x1A, 0xD0, 0xA5, 0xF2, 0x8D, 0x04,
+    0xDC, 0xA5, 0xF3, 0x8D, 0x05, 0xDC, 0xA5, 0xF4, 0x8D, 0x0D, 0xDC, 0xA5,
+    0xF5, 0x8D, 0x04, 0xDD, 0xA5, 0xF6, 0x8D, 0x05, 0xDD, 0xA5, 0xF7, 0x8D,
+    0x0D, 0xDD, 0xA9, 0x11, 0x8D, 0x0E, 0xDC, 0x8D, 0x0E, 0xDD, 0x58, 0xE6,
+    0xFC, 0xA5, 0xFC, 0x29, 0x07, 0xD0, 0x03, 0x78, 0xEA, 0x58, 0xA6, 0xFC,
+    0xBD, 0xF0, 0x10, 0xA0, 0x03, 0x88, 0xD0, 0xFD, 0x4C, 0x6B, 0x10, 0x48,
+    0x8A, 0x48, 0xA6, 0xFA, 0xAD, 0x04, 0xDC, 0x9D, 0x00, 0x20, 0xAD, 0x12,
+    0xD0, 0x9D, 0x00, 0x21, 0xAD, 0x0D, 0xDC, 0x9D, 0x00, 0x22, 0xAD, 0x19,
+    0xD0, 0x9D, 0x00, 0x23, 0x8D, 0x19, 0xD0, 0xE6, 0xFA, 0x68, 0xAA, 0x68,
+    0x40, 0x48, 0x8A, 0x48, 0xA6, 0xFB, 0xAD, 0x04, 0xDD, 0x9D, 0x00, 0x24,
+    0xAD, 0x04, 0xDC, 0x9D, 0x00, 0x25, 0xAD, 0x0D, 0xDD, 0x9D, 0x00, 0x26,
+    0xE6, 0xFB, 0x68, 0xAA, 0x68, 0x40
+};
+
+
+//! @brief    Runs irqCheckProgram and returns a digest of the memory it logged
+static u64
+runIrqScenario(VICModel model, const u8 *config)
+{
+    C64 *c64 = makeCheckMachine(model);
+    CheckRandom random(1);
+    
+    memcpy(c64->mem.ram + 0x1000, irqCheckProgram, sizeof(irqCheckProgram));
+    memcpy(c64->mem.ram + 0x00F0, config, 8);
+    c64->cpu.jumpToAddress(0x1000);
+    
+    // Stop at odd cycles and reload a snapshot every 1000 steps
+    u64 digest = 0;
+    for (unsigned i = 1; i <= 100000; i++) {
+        
+        c64->executeCycles(1 + random.next() % 23);
+        
+        if (i % 1000 == 0) {
+            Snapshot *snapshot = Snapshot::makeWithC64(c64);
+            c64->loadFromSnapshotUnsafe(snapshot);
+            delete snapshot;
+            digest = foldDigest(digest, fnv_1a_64(c64->mem.ram, 0x10000));
+        }
+    }
+    digest = foldDigest(digest, c64->cpu.cycle);
+    
+    delete c64;
+    return digest;
+}
+
+bool
+checkIrqTiming()
+{
+    /* Raster IRQ only, CIA1 IRQ only, CIA2 NMI only, raster IRQs on a bad
+     * line with CIA1 IRQs, and frequent nested interrupts from all sources
+     * on the different VICII models. The configuration goes to $F0 to $F7.
+     * The digests were recorded before interrupt polling was scheduled.
+     */
+    static const struct { VICModel model; u8 config[8]; u64 digest; } scenarios[] = {
+        
+        { PAL_6569_R3,    { 0x30, 0x01, 0x40, 0x1F, 0x7F, 0x01, 0x30, 0x7F }, 0x29810d8b09de799c },
+        { PAL_6569_R3,    { 0x30, 0x00, 0x40, 0x1F, 0x81, 0x01, 0x30, 0x7F }, 0x2f9fc8aa100bd014 },
+        { PAL_6569_R3,    { 0x30, 0x00, 0x40, 0x1F, 0x7F, 0x01, 0x30, 0x81 }, 0x657adea919fa7bce },
+        { PAL_6569_R3,    { 0x33, 0x01, 0xFF, 0x0F, 0x81, 0x01, 0x30, 0x7F }, 0x9d386794d714f0a4 },
+        { PAL_6569_R3,    { 0x80, 0x01, 0x23, 0x01, 0x81, 0x56, 0x04, 0x81 }, 0x6640e8709af94040 },
+        { PAL_6569_R1,    { 0xF8, 0x01, 0x41, 0x00, 0x81, 0xC3, 0x00, 0x81 }, 0x372dcfb6c3b5cde7 },
+        { NTSC_6567,      { 0x10, 0x01, 0x40, 0x1F, 0x81, 0x01, 0x30, 0x81 }, 0xad2666075644cc9c },
+        { NTSC_6567_R56A, { 0xF8, 0x01, 0x33, 0x02, 0x81, 0x77, 0x01, 0x81 }, 0x942502fbf46843d5 }
+    };
+    unsigned errors = 0;
+    
+    for (unsigned i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        
+        u64 digest = runIrqScenario(scenarios[i].model, scenarios[i].config);
+        if (digest != scenarios[i].digest) {
+            fprintf(stderr, "Scenario %u: digest %016llx, expected %016llx\n", i,
+                    (unsigned long long)digest,
+                    (unsigned long long)scenarios[i].digest);
+            errors++;
+        }
+    }
+    
+    printf("IRQ timing: %u of %zu scenarios differ\n",
+           errors, sizeof(scenarios) / sizeof(scenarios[0]));
+    return errors == 0;
+}
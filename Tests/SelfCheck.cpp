@@ -0,0 +1,24 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "SelfCheck.h"
+
+C64 *
+makeCheckMachine(VICModel model)
+{
+    C64 *c64 = new C64();
+    
+    c64->vic.setModel(model);
+    c64->drive1.powerOff();
+    c64->drive2.powerOff();
+    c64->setTakeAutoSnapshots(false);
+    c64->setAlwaysWarp(true);
+    
+    return c64;
+}
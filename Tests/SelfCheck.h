@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef _SELFCHECK_INC
+#define _SELFCHECK_INC
+
+#include "C64.h"
+
+/* Self checks
+ *
+ * Each check prints a single line and returns true if it passed. Details
+ * about failures go to stderr.
+ */
+
+//! @brief    Executes ADC and SBC in decimal mode for all operands
+bool checkDecimalMode();
+
+//! @brief    Compares the interrupt timing with recorded digests
+bool checkIrqTiming();
+
+//! @brief    Compares the drawn frames with recorded digests
+bool checkFrames();
+
+
+//
+// Fixtures
+//
+
+/*! @brief    Creates a machine for running a check program
+ *  @details  Both drives are switched off. The machine runs in warp mode
+ *            and takes no auto-snapshots.
+ */
+C64 *makeCheckMachine(VICModel model);
+
+/*! @brief    Pseudo random numbers of the self checks
+ *  @details  A linear congruential generator. The recorded digests depend
+ *            on the exact sequence, so it must never change.
+ */
+class CheckRandom {
+    
+    u32 seed;
+    
+public:
+    
+    CheckRandom(u32 seed) : seed(seed) { }
+    
+    //! @brief    Returns the next 16 random bits.
+    u16 next() { seed = seed * 1103515245 + 12345; return seed >> 16; }
+};
+
+//! @brief    Adds a value to a digest.
+inline u64 foldDigest(u64 digest, u64 value) { return digest * 31 + value; }
+
+#endif
@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v2
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+/* Self check runner
+ *
+ * This program runs the self checks named on the command line, or all of
+ * them if none is named. Each check is registered as a test with CTest.
+ * The exit code is 0 if all checks passed, 2 if a check failed, and 1 if a
+ * check is unknown.
+ */
+
+#include "SelfCheck.h"
+
+static const struct { const char *name; bool (*run)(); } checks[] = {
+    
+    { "decimal", checkDecimalMode },
+    { "irq",     checkIrqTiming },
+    { "frames",  checkFrames }
+};
+
+static const unsigned numChecks = sizeof(checks) / sizeof(checks[0]);
+
+static int
+runCheck(const char *name)
+{
+    for (unsigned i = 0; i < numChecks; i++) {
+        
+        if (strcmp(checks[i].name, name) == 0) {
+            bool passed = checks[i].run();
+            printf("%s: %s\n", name, passed ? "PASSED" : "FAILED");
+            return passed ? 0 : 2;
+        }
+    }
+    
+    fprintf(stderr, "Unknown self check %s\n", name);
+    return 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int result = 0;
+    
+    if (argc == 1) {
+        for (unsigned i = 0; i < numChecks; i++) {
+            result = std::max(result, runCheck(checks[i].name));
+        }
+    }
+    for (int i = 1; i < argc; i++) {
+        result = std::max(result, runCheck(argv[i]));
+    }
+    
+    return result;
+}